@@ -45,6 +45,8 @@ public class GitlabIntegration : ModuleRules
 				"Slate",
 				"SlateCore",
 				"Http",
+				"HTTPServer",
+				"ApplicationCore",
 				"Json",
 				"JsonUtilities",
 			}
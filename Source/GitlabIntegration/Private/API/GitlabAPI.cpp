@@ -11,13 +11,13 @@ GitlabAPI::GitlabAPI(): IAPI() {
 GitlabAPI::~GitlabAPI() {
 }
 
-void GitlabAPI::SetBaseUrl(FText server) {
-    Projects.Empty();
-    ApiBaseUrl = FText::FromString(server.ToString() + TEXT("/api/v4/"));
+bool GitlabAPI::SetBaseUrl(FText server) {
+    if (!IAPI::SetBaseUrl(FText::FromString(server.ToString() + TEXT("/api/v4/")))) return false;
     UE_LOG(LogGitlabIntegrationAPI, Warning, TEXT("Changing Gitlab API BaseURL to: %s"), *ApiBaseUrl.ToString());
+    return true;
 }
 
-GitlabAPI::GitlabAPI(FText base, FText token, FText LoadProject, std::function<void()> IssueCallback, std::function<void()> LabelCallback): IAPI() {
+GitlabAPI::GitlabAPI(FText base, FText token, FText LoadProject, FGitlabIntegrationIAPIIssueCallback IssueCallback, FGitlabIntegrationIAPILabelCallback LabelCallback): IAPI() {
     UE_LOG(LogGitlabIntegrationAPI, Log, TEXT("Creating Gitlab API"));
     SetBaseUrl(base);
     ApiToken = token;
@@ -25,5 +25,4 @@ GitlabAPI::GitlabAPI(FText base, FText token, FText LoadProject, std::function<v
     SetIssueCallback(IssueCallback);
     SetLabelCallback(LabelCallback);
     SetLoadProject(LoadProject);
-    GetProjectsRequest(1);
 }
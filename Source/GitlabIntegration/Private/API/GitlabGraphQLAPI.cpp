@@ -0,0 +1,473 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "../../Public/API/GitlabGraphQLAPI.h"
+#include "../../Public/API/IAPIJsonReader.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+#define GITLAB_GRAPHQL_KEY(Reader, Name) (Reader).KeyEquals(Name, sizeof(Name) - 1)
+
+GitlabGraphQLAPI::GitlabGraphQLAPI(FText base, FText token, FText LoadProject, FGitlabIntegrationIAPIIssueCallback IssueCallback, FGitlabIntegrationIAPILabelCallback LabelCallback)
+    : GitlabAPI(base, token, LoadProject, IssueCallback, LabelCallback) {
+    // The base class constructor only reached its own SetBaseUrl
+    GraphQLUrl = base.ToString() + TEXT("/api/graphql");
+}
+
+GitlabGraphQLAPI::~GitlabGraphQLAPI() {
+    FTicker::GetCoreTicker().RemoveTicker(TimelogTickHandle);
+    if (PendingTimelogs.Num() > 0) {
+        // Straight out, the scheduler goes away with us and nobody is left for the response
+        TimelogRequest(PendingTimelogs)->ProcessRequest();
+    }
+}
+
+bool GitlabGraphQLAPI::SetBaseUrl(FText server) {
+    GraphQLUrl = server.ToString() + TEXT("/api/graphql");
+    return GitlabAPI::SetBaseUrl(server);
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> GitlabGraphQLAPI::GraphQLRequest(const FString &Query, const TSharedRef<FJsonObject> &Variables) {
+    TSharedRef<FJsonObject> Body = MakeShared<FJsonObject>();
+    Body->SetStringField(TEXT("query"), Query);
+    Body->SetObjectField(TEXT("variables"), Variables);
+    FString Content;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Content);
+    FJsonSerializer::Serialize(Body, Writer);
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    UE_LOG(LogGitlabIntegrationAPI, Log, TEXT("Sending GraphQL request to: %s"), *GraphQLUrl);
+    Request->SetURL(GraphQLUrl);
+    Request->SetVerb("POST");
+    SetRequestHeaders(Request);
+    Request->SetContentAsString(Content);
+    return Request;
+}
+
+void GitlabGraphQLAPI::FetchProjectContent(EGitlabIntegrationIAPIRequestPriority Priority) {
+    // A group is loaded project by project through REST, the queries here are built around one project
+    if (IsGroupMode()) {
+        GitlabAPI::FetchProjectContent(Priority);
+        return;
+    }
+    FGitlabGraphQLAPIQuery Query;
+    BeginIssues(Query, Priority, bIncrementalSync && IssueWatermarks.Contains(SelectedProject.id));
+    BeginLabels(Query, Priority);
+    SendQuery(Query);
+}
+
+void GitlabGraphQLAPI::FetchProjectIssues(EGitlabIntegrationIAPIRequestPriority Priority) {
+    if (IsGroupMode()) {
+        GitlabAPI::FetchProjectIssues(Priority);
+        return;
+    }
+    FGitlabGraphQLAPIQuery Query;
+    BeginIssues(Query, Priority, false);
+    SendQuery(Query);
+}
+
+void GitlabGraphQLAPI::FetchProjectIssueChanges(EGitlabIntegrationIAPIRequestPriority Priority) {
+    if (IsGroupMode()) {
+        GitlabAPI::FetchProjectIssueChanges(Priority);
+        return;
+    }
+    FGitlabGraphQLAPIQuery Query;
+    BeginIssues(Query, Priority, IssueWatermarks.Contains(SelectedProject.id));
+    SendQuery(Query);
+}
+
+void GitlabGraphQLAPI::FetchProjectLabels(EGitlabIntegrationIAPIRequestPriority Priority) {
+    if (IsGroupMode()) {
+        GitlabAPI::FetchProjectLabels(Priority);
+        return;
+    }
+    FGitlabGraphQLAPIQuery Query;
+    BeginLabels(Query, Priority);
+    SendQuery(Query);
+}
+
+void GitlabGraphQLAPI::BeginIssues(FGitlabGraphQLAPIQuery &Query, EGitlabIntegrationIAPIRequestPriority Priority, bool bChanges) {
+    FGitlabIntegrationIAPIIssuePartition &Partition = Partitions.FindOrAdd(SelectedProject.id);
+    Partition.Fetch.Restart(Priority);
+    Partition.Fetch.Serial = ++IssueFetchSerial;
+    Partition.bLoading = true;
+    Query.ProjectId = SelectedProject.id;
+    Query.FullPath = SelectedProject.path_with_namespace;
+    Query.Priority = Priority;
+    Query.bIssues = true;
+    Query.IssuesSerial = Partition.Fetch.Serial;
+    if (bChanges) {
+        Partition.PendingWatermark = IssueWatermarks[SelectedProject.id];
+        Partition.bFull = false;
+        Query.UpdatedAfter = Partition.PendingWatermark.ToIso8601();
+    } else {
+        Partition.PendingWatermark = FDateTime::FromUnixTimestamp(0);
+        Partition.bFull = true;
+        Partition.SeenIds.Empty();
+    }
+}
+
+void GitlabGraphQLAPI::BeginLabels(FGitlabGraphQLAPIQuery &Query, EGitlabIntegrationIAPIRequestPriority Priority) {
+    LabelsFetch.Restart(Priority);
+    bLabelFetchFailed = false;
+    SeenLabelIds.Empty();
+    Query.ProjectId = SelectedProject.id;
+    Query.FullPath = SelectedProject.path_with_namespace;
+    if (!Query.bIssues || Priority < Query.Priority) {
+        Query.Priority = Priority;
+    }
+    Query.bLabels = true;
+    Query.LabelsSerial = LabelsFetch.Serial;
+}
+
+/** Cursors and filters which are not set are sent as null */
+static TSharedRef<FJsonValue> StringOrNull(const FString &Value) {
+    if (Value.IsEmpty()) return MakeShared<FJsonValueNull>();
+    return MakeShared<FJsonValueString>(Value);
+}
+
+void GitlabGraphQLAPI::SendQuery(const FGitlabGraphQLAPIQuery &Query) {
+    // Parts without more pages are left out with @include, the project is resolved only once per request
+    static const FString Text = FString::Printf(TEXT(
+        "query($fullPath: ID!, $withIssues: Boolean!, $issuesAfter: String, $state: IssuableState, $updatedAfter: Time, "
+        "$withLabels: Boolean!, $labelsAfter: String) { project(fullPath: $fullPath) { "
+        "issues(first: %d, after: $issuesAfter, state: $state, updatedAfter: $updatedAfter) @include(if: $withIssues) { "
+        "pageInfo { hasNextPage endCursor } nodes { id iid title state webUrl updatedAt labels { nodes { title } } } } "
+        "labels(first: %d, after: $labelsAfter, includeAncestorGroups: true) @include(if: $withLabels) { "
+        "pageInfo { hasNextPage endCursor } nodes { id title color textColor description } } } }"), PageSize, PageSize);
+
+    TSharedRef<FJsonObject> Variables = MakeShared<FJsonObject>();
+    Variables->SetStringField(TEXT("fullPath"), Query.FullPath);
+    Variables->SetBoolField(TEXT("withIssues"), Query.bIssues);
+    Variables->SetBoolField(TEXT("withLabels"), Query.bLabels);
+    Variables->SetField(TEXT("issuesAfter"), StringOrNull(Query.IssuesCursor));
+    Variables->SetField(TEXT("labelsAfter"), StringOrNull(Query.LabelsCursor));
+    // Changes include closed issues so that they can be dropped, like state=all of the REST API
+    Variables->SetField(TEXT("state"), StringOrNull(Query.UpdatedAfter.IsEmpty() ? TEXT("opened") : TEXT("")));
+    Variables->SetField(TEXT("updatedAfter"), StringOrNull(Query.UpdatedAfter));
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = GraphQLRequest(Text, Variables);
+    Request->OnProcessRequestComplete().BindRaw(this, &GitlabGraphQLAPI::QueryResponse, Query);
+    Send(Request, Query.Priority, ProjectToken);
+}
+
+void GitlabGraphQLAPI::QueryResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FGitlabGraphQLAPIQuery Query) {
+    const FGitlabIntegrationIAPIIssuePartition *Partition = Partitions.Find(Query.ProjectId);
+    const bool bIssuesCurrent = Query.bIssues && Partition != nullptr && Query.IssuesSerial == Partition->Fetch.Serial;
+    const bool bLabelsCurrent = Query.bLabels && Query.LabelsSerial == LabelsFetch.Serial;
+    if (!bIssuesCurrent && !bLabelsCurrent) return;
+    if (!ResponseIsValid(Response, bWasSuccessful)) Response = nullptr;
+
+    DecodeResponseWith(Response, ProjectToken,
+        [](const FString &Url, const TArray<uint8> &Content) {
+            FGitlabGraphQLAPIPage *Page = new FGitlabGraphQLAPIPage();
+            DecodePage(Content, *Page);
+            return Page;
+        },
+        [this, Query](FHttpResponsePtr Decoded, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed) {
+            QueryDecoded(Decoded, Parsed, Query);
+        });
+}
+
+void GitlabGraphQLAPI::QueryDecoded(FHttpResponsePtr Response, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed, const FGitlabGraphQLAPIQuery &Query) {
+    // POSTs are never asked again with If-None-Match, the body is of no use in the cache
+    ResponseCache.Remove(GraphQLUrl);
+    FGitlabGraphQLAPIPage *Page = Response.IsValid() && Parsed.IsValid() ? static_cast<FGitlabGraphQLAPIPage *>(Parsed.Get()) : nullptr;
+    if (Page != nullptr && !Page->bValid) {
+        UE_LOG(LogGitlabIntegrationAPI, Warning, TEXT("GraphQL query for %s failed: %s"), *Query.FullPath, *Page->Error);
+        Page = nullptr;
+    }
+
+    FGitlabGraphQLAPIQuery Next = Query;
+    Next.bIssues = false;
+    Next.bLabels = false;
+    FGitlabIntegrationIAPIIssuePartition *Partition = Partitions.Find(Query.ProjectId);
+    if (Query.bIssues && Partition != nullptr && Query.IssuesSerial == Partition->Fetch.Serial) {
+        if (Page == nullptr || !Page->bHasIssues) {
+            FailIssueFetch(Query.ProjectId);
+            CompleteIssueFetch(Query.ProjectId);
+        } else {
+            for (FGitlabIntegrationIAPIIssue &Issue : Page->Issues.Items) {
+                Issue.project_id = Query.ProjectId;
+            }
+            MergeIssuesPage(*Partition, Page->Issues);
+            if (Page->bMoreIssues) {
+                Next.bIssues = true;
+                Next.IssuesCursor = Page->IssuesCursor;
+                Next.Priority = Partition->Fetch.Priority;
+            } else {
+                CompleteIssueFetch(Query.ProjectId);
+            }
+        }
+    }
+    if (Query.bLabels && Query.LabelsSerial == LabelsFetch.Serial) {
+        if (Page == nullptr || !Page->bHasLabels) {
+            bLabelFetchFailed = true;
+            CompleteLabelFetch();
+        } else {
+            MergeLabelsPage(Page->Labels);
+            if (Page->bMoreLabels) {
+                Next.bLabels = true;
+                Next.LabelsCursor = Page->LabelsCursor;
+                if (!Next.bIssues || LabelsFetch.Priority < Next.Priority) {
+                    Next.Priority = LabelsFetch.Priority;
+                }
+            } else {
+                CompleteLabelFetch();
+            }
+        }
+    }
+
+    // Cursors only allow one page after another, both lists continue in the same request
+    if (Next.bIssues || Next.bLabels) {
+        SendQuery(Next);
+    }
+}
+
+/** "gid://gitlab/Issue/123", the number is the id the REST API uses */
+static bool ReadGlobalId(FGitlabIntegrationIAPIJsonReader &Reader, int32 &Out) {
+    FString Gid;
+    if (!Reader.ReadString(Gid)) return false;
+    int32 Slash = INDEX_NONE;
+    Gid.FindLastChar(TEXT('/'), Slash);
+    Out = FCString::Atoi(*Gid + Slash + 1);
+    return true;
+}
+
+static bool ReadPageInfo(FGitlabIntegrationIAPIJsonReader &Reader, bool &bMore, FString &Cursor) {
+    if (!Reader.BeginObject()) return false;
+    while (Reader.NextKey()) {
+        if (GITLAB_GRAPHQL_KEY(Reader, "hasNextPage")) {
+            Reader.ReadBool(bMore);
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "endCursor")) {
+            Reader.ReadString(Cursor);
+        } else {
+            Reader.SkipValue();
+        }
+    }
+    return Reader.IsValid();
+}
+
+/** Issue labels are a connection of their own, only the titles are asked for */
+static bool ReadLabelTitles(FGitlabIntegrationIAPIJsonReader &Reader, TArray<FString> &Out) {
+    if (!Reader.BeginObject()) return false;
+    while (Reader.NextKey()) {
+        if (!GITLAB_GRAPHQL_KEY(Reader, "nodes")) {
+            Reader.SkipValue();
+            continue;
+        }
+        if (!Reader.BeginArray()) return false;
+        while (Reader.NextElement()) {
+            if (!Reader.BeginObject()) return false;
+            while (Reader.NextKey()) {
+                if (GITLAB_GRAPHQL_KEY(Reader, "title")) {
+                    Reader.ReadString(Out[Out.AddDefaulted()]);
+                } else {
+                    Reader.SkipValue();
+                }
+            }
+        }
+    }
+    return Reader.IsValid();
+}
+
+static bool ReadIssue(FGitlabIntegrationIAPIJsonReader &Reader, FGitlabIntegrationIAPIIssue &Out) {
+    if (!Reader.BeginObject()) return false;
+    while (Reader.NextKey()) {
+        if (GITLAB_GRAPHQL_KEY(Reader, "id")) {
+            ReadGlobalId(Reader, Out.id);
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "iid")) {
+            // iid is an ID scalar, which GraphQL serializes as a string
+            FString Iid;
+            Reader.ReadString(Iid);
+            Out.iid = FCString::Atoi(*Iid);
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "title")) {
+            Reader.ReadString(Out.title);
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "state")) {
+            Reader.ReadString(Out.state);
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "webUrl")) {
+            Reader.ReadString(Out.web_url);
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "updatedAt")) {
+            Reader.ReadDateTime(Out.updated_at);
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "labels")) {
+            ReadLabelTitles(Reader, Out.labels);
+        } else {
+            Reader.SkipValue();
+        }
+    }
+    return Reader.IsValid();
+}
+
+static bool ReadLabel(FGitlabIntegrationIAPIJsonReader &Reader, FGitlabIntegrationIAPILabel &Out) {
+    if (!Reader.BeginObject()) return false;
+    while (Reader.NextKey()) {
+        if (GITLAB_GRAPHQL_KEY(Reader, "id")) {
+            ReadGlobalId(Reader, Out.id);
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "title")) {
+            Reader.ReadString(Out.name);
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "color")) {
+            Reader.ReadString(Out.color);
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "textColor")) {
+            Reader.ReadString(Out.text_color);
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "description")) {
+            Reader.ReadString(Out.description);
+        } else {
+            Reader.SkipValue();
+        }
+    }
+    IAPI::ParseLabelColors(Out);
+    return Reader.IsValid();
+}
+
+template <typename ItemType>
+static bool ReadConnection(FGitlabIntegrationIAPIJsonReader &Reader, TArray<ItemType> &Items, bool &bMore, FString &Cursor,
+                           bool (*ReadItem)(FGitlabIntegrationIAPIJsonReader &, ItemType &)) {
+    if (!Reader.BeginObject()) return false;
+    while (Reader.NextKey()) {
+        if (GITLAB_GRAPHQL_KEY(Reader, "pageInfo")) {
+            if (!ReadPageInfo(Reader, bMore, Cursor)) return false;
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "nodes")) {
+            if (!Reader.BeginArray()) return false;
+            while (Reader.NextElement()) {
+                if (!ReadItem(Reader, Items[Items.AddDefaulted()])) return false;
+            }
+        } else {
+            Reader.SkipValue();
+        }
+    }
+    return Reader.IsValid();
+}
+
+static bool ReadProject(FGitlabIntegrationIAPIJsonReader &Reader, FGitlabGraphQLAPIPage &Out) {
+    // A project which does not exist or is not visible comes back as null and fails here
+    if (!Reader.BeginObject()) return false;
+    while (Reader.NextKey()) {
+        if (GITLAB_GRAPHQL_KEY(Reader, "issues")) {
+            Out.bHasIssues = ReadConnection(Reader, Out.Issues.Items, Out.bMoreIssues, Out.IssuesCursor, &ReadIssue);
+            if (!Out.bHasIssues) return false;
+        } else if (GITLAB_GRAPHQL_KEY(Reader, "labels")) {
+            Out.bHasLabels = ReadConnection(Reader, Out.Labels.Items, Out.bMoreLabels, Out.LabelsCursor, &ReadLabel);
+            if (!Out.bHasLabels) return false;
+        } else {
+            Reader.SkipValue();
+        }
+    }
+    return Reader.IsValid();
+}
+
+static void ReadErrors(FGitlabIntegrationIAPIJsonReader &Reader, FString &Out) {
+    if (!Reader.BeginArray()) return;
+    while (Reader.NextElement()) {
+        if (!Reader.BeginObject()) return;
+        while (Reader.NextKey()) {
+            if (GITLAB_GRAPHQL_KEY(Reader, "message") && Out.IsEmpty()) {
+                Reader.ReadString(Out);
+            } else {
+                Reader.SkipValue();
+            }
+        }
+    }
+}
+
+void GitlabGraphQLAPI::DecodePage(const TArray<uint8> &Content, FGitlabGraphQLAPIPage &Out) {
+    FGitlabIntegrationIAPIJsonReader Reader(Content.GetData(), Content.Num());
+    bool bErrors = false;
+    if (Reader.BeginObject()) {
+        while (Reader.NextKey()) {
+            if (GITLAB_GRAPHQL_KEY(Reader, "data")) {
+                if (!Reader.BeginObject()) break;
+                while (Reader.NextKey()) {
+                    if (GITLAB_GRAPHQL_KEY(Reader, "project")) {
+                        if (!ReadProject(Reader, Out)) break;
+                    } else {
+                        Reader.SkipValue();
+                    }
+                }
+            } else if (GITLAB_GRAPHQL_KEY(Reader, "errors")) {
+                // Partial data next to errors is not trusted, a fetch either completes or fails
+                bErrors = true;
+                ReadErrors(Reader, Out.Error);
+            } else {
+                Reader.SkipValue();
+            }
+        }
+    }
+    Out.bValid = Reader.IsValid() && !bErrors;
+    if (!Out.bValid && Out.Error.IsEmpty()) {
+        Out.Error = TEXT("malformed response");
+    }
+}
+
+void GitlabGraphQLAPI::RecordTimeSpent(TSharedPtr<FGitlabIntegrationIAPIIssue> issue, int time) {
+    FGitlabGraphQLAPITimelog &Timelog = PendingTimelogs[PendingTimelogs.AddDefaulted()];
+    Timelog.IssueId = issue->id;
+    Timelog.Seconds = time;
+    Timelog.Issue = issue;
+    if (!TimelogTickHandle.IsValid()) {
+        TimelogTickHandle = FTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &GitlabGraphQLAPI::FlushTimelogs), TimelogBatchDelay);
+    }
+}
+
+bool GitlabGraphQLAPI::FlushTimelogs(float DeltaTime) {
+    TimelogTickHandle.Reset();
+    if (PendingTimelogs.Num() == 0) return false;
+
+    TArray<FGitlabGraphQLAPITimelog> Timelogs = MoveTemp(PendingTimelogs);
+    PendingTimelogs.Reset();
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = TimelogRequest(Timelogs);
+    Request->OnProcessRequestComplete().BindRaw(this, &GitlabGraphQLAPI::TimelogResponse, Timelogs);
+    Send(Request, EGitlabIntegrationIAPIRequestPriority::Interactive);
+    return false;
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> GitlabGraphQLAPI::TimelogRequest(const TArray<FGitlabGraphQLAPITimelog> &Timelogs) {
+    // One aliased mutation per entry, t0: timelogCreate(input: $t0) and so on
+    TArray<FString> Declarations;
+    FString Mutations;
+    TSharedRef<FJsonObject> Variables = MakeShared<FJsonObject>();
+    const FString SpentAt = FDateTime::UtcNow().ToIso8601();
+    for (int32 Index = 0; Index < Timelogs.Num(); Index++) {
+        Declarations.Add(FString::Printf(TEXT("$t%d: TimelogCreateInput!"), Index));
+        Mutations += FString::Printf(TEXT("t%d: timelogCreate(input: $t%d) { errors } "), Index, Index);
+        TSharedRef<FJsonObject> Input = MakeShared<FJsonObject>();
+        Input->SetStringField(TEXT("issuableId"), FString::Printf(TEXT("gid://gitlab/Issue/%d"), Timelogs[Index].IssueId));
+        Input->SetStringField(TEXT("timeSpent"), FString::Printf(TEXT("%ds"), Timelogs[Index].Seconds));
+        Input->SetStringField(TEXT("spentAt"), SpentAt);
+        Input->SetStringField(TEXT("summary"), TEXT(""));
+        Variables->SetObjectField(FString::Printf(TEXT("t%d"), Index), Input);
+    }
+    return GraphQLRequest(TEXT("mutation(") + FString::Join(Declarations, TEXT(", ")) + TEXT(") { ") + Mutations + TEXT("}"), Variables);
+}
+
+void GitlabGraphQLAPI::TimelogResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TArray<FGitlabGraphQLAPITimelog> Timelogs) {
+    if (!ResponseIsValid(Response, bWasSuccessful)) return;
+
+    TSharedPtr<FJsonObject> Root;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || Root->HasField(TEXT("errors"))) {
+        // Servers before timelogCreate reject the whole document, they still take the REST call
+        UE_LOG(LogGitlabIntegrationAPI, Warning, TEXT("GraphQL time tracking failed, recording %d entries through REST"), Timelogs.Num());
+        for (const FGitlabGraphQLAPITimelog &Timelog : Timelogs) {
+            RecordTimeSpentThroughRest(Timelog);
+        }
+        return;
+    }
+
+    const TSharedPtr<FJsonObject> *Data = nullptr;
+    if (!Root->TryGetObjectField(TEXT("data"), Data)) return;
+    for (int32 Index = 0; Index < Timelogs.Num(); Index++) {
+        const TSharedPtr<FJsonObject> *Result = nullptr;
+        const TArray<TSharedPtr<FJsonValue>> *Errors = nullptr;
+        if ((*Data)->TryGetObjectField(FString::Printf(TEXT("t%d"), Index), Result) &&
+            (*Result)->TryGetArrayField(TEXT("errors"), Errors) && Errors->Num() > 0) {
+            UE_LOG(LogGitlabIntegrationAPI, Warning, TEXT("Time spent on issue #%d not recorded: %s"),
+                   Timelogs[Index].Issue->iid, *(*Errors)[0]->AsString());
+        }
+    }
+    UE_LOG(LogGitlabIntegrationAPI, Log, TEXT("Recorded time spent on %d issues in one request"), Timelogs.Num());
+}
+
+void GitlabGraphQLAPI::RecordTimeSpentThroughRest(const FGitlabGraphQLAPITimelog &Timelog) {
+    GitlabAPI::RecordTimeSpent(Timelog.Issue, Timelog.Seconds);
+}
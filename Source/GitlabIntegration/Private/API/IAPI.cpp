@@ -2,6 +2,14 @@
 
 
 #include "../../Public/API/IAPI.h"
+#include "../../Public/API/IAPIJsonReader.h"
+#include "PlatformHttp.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Async/TaskGraphInterfaces.h"
+
+#define GITLAB_INTEGRATION_CACHE_MAGIC 0x474C4943
 
 DEFINE_LOG_CATEGORY(LogGitlabIntegrationIAPI);
 
@@ -11,12 +19,27 @@ IAPI::IAPI() {
 }
 
 IAPI::~IAPI() {
+    if (DecodeTickHandle.IsValid()) {
+        FTicker::GetCoreTicker().RemoveTicker(DecodeTickHandle);
+    }
 }
 
-void IAPI::SetBaseUrl(FText server) {
+bool IAPI::SetBaseUrl(FText server) {
+    // Called on every settings save, the project list and the validators only go with a different server
+    if (server.ToString().Equals(ApiBaseUrl.ToString())) return false;
+    CancelServerRequests();
     Projects.Empty();
+    ProjectsVersion++;
+    bProjectsRequested = false;
+    bProjectsLoaded = false;
+    ResponseCache.Empty();
     ApiBaseUrl = server;
+    // Issues, labels and project ids of the old server mean nothing here, the caller loads the project again
+    ResetStore();
+    IssueWatermarks.Empty();
+    SelectedProject = FGitlabIntegrationIAPIProject();
     UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Changing Generic API BaseURL to: %s"), *ApiBaseUrl.ToString());
+    return true;
 }
 
 void IAPI::SetToken(FText token) {
@@ -27,6 +50,39 @@ void IAPI::SetLoadProject(FText project) {
     InitialProjectName = project;
 }
 
+void IAPI::SetLoadProjectLocation(int32 ProjectId, FString ProjectPath) {
+    InitialProjectId = ProjectId;
+    InitialProjectPath = ProjectPath;
+}
+
+void IAPI::SetLoadGroup(FString Path) {
+    GroupPath = Path;
+}
+
+void IAPI::SetGroup(FString Path) {
+    if (Path == GroupPath) return;
+    CancelProjectRequests();
+    GroupPath = Path;
+    // The project list is the group's in group mode, pages of the other list must not end up in it
+    Projects.Empty();
+    ProjectsVersion++;
+    ProjectsFetch.Serial++;
+    bProjectsRequested = false;
+    bProjectsLoaded = false;
+    ResetStore();
+    IssueWatermarks.Empty();
+    if (IsGroupMode()) {
+        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Loading the projects of group %s"), *GroupPath);
+        FetchProjectContent();
+    } else if (SelectedProject.id != -1) {
+        SetProject(SelectedProject);
+    }
+}
+
+void IAPI::SetProjectCallback(std::function<void()> callback) {
+    ProjectCallback = callback;
+}
+
 void IAPI::SetRequestHeaders(TSharedRef<IHttpRequest, ESPMode::ThreadSafe> &Request) {
     Request->SetHeader(TEXT("User-Agent"), TEXT("X-UnrealEngine-Agent"));
     Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
@@ -45,13 +101,21 @@ TSharedRef<IHttpRequest, ESPMode::ThreadSafe> IAPI::RequestWithRoute(FString Sub
 }
 
 TSharedRef<IHttpRequest, ESPMode::ThreadSafe> IAPI::GetRequest(FString Subroute, int32 page) {
-    if (page > 1) {
+    if (page > 0) {
         FString separator = TEXT("?");
         if (Subroute.Contains(TEXT("?"), ESearchCase::CaseSensitive, ESearchDir::FromEnd)) { separator = TEXT("&"); }
-        Subroute += separator + TEXT("page=") + FString::FromInt(page);
+        Subroute += separator + FString::Printf(TEXT("per_page=%d&page=%d"), PageSize, page);
     }
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = RequestWithRoute(Subroute);
     Request->SetVerb("GET");
+    if (FGitlabIntegrationIAPICacheEntry *Entry = ResponseCache.Find(Request->GetURL())) {
+        if (!Entry->ETag.IsEmpty()) {
+            Request->SetHeader(TEXT("If-None-Match"), Entry->ETag);
+        }
+        if (!Entry->LastModified.IsEmpty()) {
+            Request->SetHeader(TEXT("If-Modified-Since"), Entry->LastModified);
+        }
+    }
     return Request;
 }
 
@@ -62,13 +126,45 @@ TSharedRef<IHttpRequest, ESPMode::ThreadSafe> IAPI::PostRequest(FString Subroute
     return Request;
 }
 
-void IAPI::Send(TSharedRef<IHttpRequest, ESPMode::ThreadSafe> &Request) {
-    Request->ProcessRequest();
+void IAPI::Send(TSharedRef<IHttpRequest, ESPMode::ThreadSafe> &Request, EGitlabIntegrationIAPIRequestPriority Priority,
+                const FGitlabIntegrationIAPICancellationTokenPtr &Token) {
+    Scheduler.Enqueue(Request, Priority, Token);
+}
+
+static void ReplaceCancellationToken(FGitlabIntegrationIAPICancellationTokenPtr &Token) {
+    const int32 Generation = Token->Generation + 1;
+    Token->bCancelled = true;
+    Token = MakeShareable(new FGitlabIntegrationIAPICancellationToken());
+    Token->Generation = Generation;
+}
+
+void IAPI::CancelProjectRequests() {
+    ReplaceCancellationToken(ProjectToken);
+    Scheduler.CancelRequests();
+    // The cancelled pages never arrive, a partition left loading would hold back CompleteIssueFetch for good
+    for (auto &Partition : Partitions) {
+        if (Partition.Value.bLoading) {
+            Partition.Value.bLoading = false;
+            FailIssueFetch(Partition.Key);
+        }
+    }
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Cancelled project requests, generation %d"), ProjectToken->Generation);
+}
+
+void IAPI::CancelServerRequests() {
+    ReplaceCancellationToken(ServerToken);
+    CancelProjectRequests();
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Cancelled server requests, generation %d"), ServerToken->Generation);
+}
+
+void IAPI::SetRequestLimits(int32 MaxInFlight, float RequestsPerSecond) {
+    Scheduler.SetLimits(MaxInFlight, RequestsPerSecond);
 }
 
 bool IAPI::ResponseIsValid(FHttpResponsePtr Response, bool bWasSuccessful) {
     if (!bWasSuccessful || !Response.IsValid()) return false;
     if (EHttpResponseCodes::IsOk(Response->GetResponseCode())) return true;
+    if (Response->GetResponseCode() == EHttpResponseCodes::NotModified && ResponseCache.Contains(Response->GetURL())) return true;
     else {
         UE_LOG(LogGitlabIntegrationIAPI, Error, TEXT("Http Response returned error code: %d"),
                Response->GetResponseCode());
@@ -83,46 +179,353 @@ void IAPI::GetJsonStringFromStruct(StructType FilledStruct, FString &StringOutpu
 
 template<typename StructType>
 void IAPI::GetStructFromJsonString(FHttpResponsePtr Response, StructType &StructOutput) {
-    StructType StructData;
-    FString JsonString = Response->GetContentAsString();
-    FJsonObjectConverter::JsonObjectStringToUStruct<StructType>(JsonString, &StructOutput, 0, 1);
+    // Single objects are fetched conditionally too since the activity poll, a 304 has its body in the cache
+    const TArray<uint8> *Content = &Response->GetContent();
+    if (Response->GetResponseCode() == EHttpResponseCodes::NotModified) {
+        const FGitlabIntegrationIAPICacheEntry *Entry = ResponseCache.Find(Response->GetURL());
+        if (Entry == nullptr || !Entry->Content.IsValid()) return;
+        Content = Entry->Content.Get();
+    }
+    if (!FGitlabIntegrationIAPIJsonDecoder::DecodeObject(*Content, StructOutput)) {
+        FGitlabIntegrationIAPIJsonDecoder::DecodeObjectWithReflection(*Content, StructOutput);
+    }
+}
+
+bool IAPI::HandlePage(FGitlabIntegrationIAPIPagedFetch &Fetch, int32 Page, FHttpResponsePtr Response,
+                      TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed, TFunctionRef<void(int32)> RequestPage,
+                      TFunctionRef<void(FGitlabIntegrationIAPIDecodedPayload &)> MergePage) {
+    Fetch.InFlight--;
+
+    if (Page == 1 && Response.IsValid() && MaxConcurrentPages > 1) {
+        // Gitlab leaves X-Total-Pages out for very large collections, then we just follow X-Next-Page
+        Fetch.TotalPages = FCString::Atoi(*GetResponseHeader(Response, TEXT("X-Total-Pages")));
+        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Total pages: %d (%s items)"), Fetch.TotalPages,
+               *GetResponseHeader(Response, TEXT("X-Total")))
+    }
+
+    if (Fetch.TotalPages <= 0) {
+        if (Parsed.IsValid()) {
+            MergePage(*Parsed);
+        }
+        int current_page = Response.IsValid() ? FCString::Atoi(*GetResponseHeader(Response, TEXT("X-Page"))) : Page;
+        int next_page = Response.IsValid() ? FCString::Atoi(*GetResponseHeader(Response, TEXT("X-Next-Page"))) : 0;
+
+        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Current page: %d"), current_page)
+        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Next page: %d"), next_page)
+
+        if (next_page > current_page) {
+            Fetch.InFlight++;
+            RequestPage(next_page);
+            return false;
+        }
+        return true;
+    }
+
+    while (Fetch.InFlight < MaxConcurrentPages && Fetch.NextPageToRequest <= Fetch.TotalPages) {
+        Fetch.InFlight++;
+        RequestPage(Fetch.NextPageToRequest++);
+    }
+
+    Fetch.PendingPages.Add(Page, Parsed);
+    while (Fetch.PendingPages.Contains(Fetch.NextPageToMerge)) {
+        TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> PageParsed = Fetch.PendingPages.FindAndRemoveChecked(Fetch.NextPageToMerge);
+        if (PageParsed.IsValid()) {
+            MergePage(*PageParsed);
+        } else {
+            UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Skipping failed page %d"), Fetch.NextPageToMerge);
+        }
+        Fetch.NextPageToMerge++;
+    }
+
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Merged %d of %d pages, %d in flight"), Fetch.NextPageToMerge - 1,
+           Fetch.TotalPages, Fetch.InFlight)
+
+    return Fetch.NextPageToMerge > Fetch.TotalPages;
+}
+
+void IAPI::SetMaxConcurrentPages(int32 MaxPages) {
+    MaxConcurrentPages = FMath::Max(1, MaxPages);
 }
 
-void IAPI::GetProjectsRequest(int32 page) {
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = GetRequest("projects", page);
-    Request->OnProcessRequestComplete().BindRaw(this, &IAPI::ProjectsResponse);
-    Send(Request);
+void IAPI::ResolveProject() {
+    FString Route;
+    if (InitialProjectId > 0) {
+        Route = FString::Printf(TEXT("projects/%d"), InitialProjectId);
+    } else if (!InitialProjectPath.IsEmpty()) {
+        Route = TEXT("projects/") + FPlatformHttp::UrlEncode(InitialProjectPath);
+    }
+    if (!Route.IsEmpty()) {
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = GetRequest(Route, 0);
+        Request->OnProcessRequestComplete().BindRaw(this, &IAPI::ProjectResponse);
+        Send(Request, EGitlabIntegrationIAPIRequestPriority::Foreground, ProjectToken);
+        return;
+    }
+
+    if (!InitialProjectName.IsEmpty()) {
+        // Settings from before the project path was stored only know the name, search for it
+        FString Name = InitialProjectName.ToString();
+        Name.Split(TEXT(" / "), nullptr, &Name, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = GetRequest(
+            TEXT("projects?simple=true&search=") + FPlatformHttp::UrlEncode(Name), 1);
+        Request->OnProcessRequestComplete().BindRaw(this, &IAPI::ProjectSearchResponse);
+        Send(Request, EGitlabIntegrationIAPIRequestPriority::Foreground, ProjectToken);
+    }
 }
 
-void IAPI::ProjectsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful) {
+void IAPI::ProjectResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful) {
+    if (!ResponseIsValid(Response, bWasSuccessful)) {
+        // The stored id or path may be stale (project moved or recreated), try the next best thing
+        if (InitialProjectId > 0) {
+            InitialProjectId = -1;
+        } else {
+            InitialProjectPath.Empty();
+        }
+        ResolveProject();
+        return;
+    }
+
+    FGitlabIntegrationIAPIProject Project;
+    GetStructFromJsonString<FGitlabIntegrationIAPIProject>(Response, Project);
+    if (Project.id == -1) return;
+
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Found selected project %s"), *Project.path_with_namespace);
+    Projects.Add(Project.id, Project);
+    ProjectsVersion++;
+    SetProject(Project);
+    if (ProjectCallback) {
+        ProjectCallback();
+    }
+}
+
+void IAPI::ProjectSearchResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful) {
     if (!ResponseIsValid(Response, bWasSuccessful)) return;
 
-    TArray<FGitlabIntegrationIAPIProject> LocalProjects;
-    FString JsonString = Response->GetContentAsString();
-    FJsonObjectConverter::JsonArrayStringToUStruct(JsonString, &LocalProjects, 0, 0);
-    for (auto &Project : LocalProjects) {
-        if (!Projects.Contains(Project.id)) {
-            Projects.Emplace(Project.id, Project);
-            if (SelectedProject.id == -1) {
-                if (Project.name_with_namespace == InitialProjectName.ToString()) {
-                    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Found selected project"))
-                    SetProject(Project);
-                }
+    DecodeResponse<FGitlabIntegrationIAPIProject>(Response, ProjectToken,
+        [this](FHttpResponsePtr, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed) { ProjectSearchDecoded(Parsed); });
+}
+
+void IAPI::ProjectSearchDecoded(TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed) {
+    if (!Parsed.IsValid()) return;
+    for (auto &Project : static_cast<TGitlabIntegrationIAPIDecodedArray<FGitlabIntegrationIAPIProject> &>(*Parsed).Items) {
+        if (Project.name_with_namespace == InitialProjectName.ToString()) {
+            UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Found selected project"))
+            Projects.Add(Project.id, Project);
+            ProjectsVersion++;
+            SetProject(Project);
+            if (ProjectCallback) {
+                ProjectCallback();
+            }
+            return;
+        }
+    }
+    UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Project %s not found"), *InitialProjectName.ToString());
+}
+
+void IAPI::EnsureProjectsLoaded() {
+    if (!bProjectsRequested) {
+        bProjectsRequested = true;
+        FetchProjects();
+    }
+}
+
+bool IAPI::AreProjectsLoading() {
+    return bProjectsRequested && !bProjectsLoaded;
+}
+
+void IAPI::FetchProjects(EGitlabIntegrationIAPIRequestPriority Priority) {
+    bProjectsRequested = true;
+    bProjectsLoaded = false;
+    bProjectFetchFailed = false;
+    SeenProjectIds.Empty();
+    // Outside of group mode only the project picker needs the list, the user is waiting for it
+    ProjectsFetch.Restart(Priority);
+    GetProjectsRequest(1, ProjectsFetch.Serial);
+}
+
+FString IAPI::GetResponseHeader(FHttpResponsePtr Response, const FString &Name) {
+    if (Response->GetResponseCode() == EHttpResponseCodes::NotModified) {
+        if (FGitlabIntegrationIAPICacheEntry *Entry = ResponseCache.Find(Response->GetURL())) {
+            return Entry->Headers.FindRef(Name);
+        }
+    }
+    return Response->GetHeader(Name);
+}
+
+/** Derived fields which can be computed by the decode task, nothing to do for most types */
+template<typename StructType>
+static void PrepareDecodedItems(TArray<StructType> &Items) {
+}
+
+static void PrepareDecodedItems(TArray<FGitlabIntegrationIAPILabel> &Labels) {
+    for (FGitlabIntegrationIAPILabel &Label : Labels) {
+        IAPI::ParseLabelColors(Label);
+    }
+}
+
+template<typename StructType>
+void IAPI::DecodeResponse(FHttpResponsePtr Response, const FGitlabIntegrationIAPICancellationTokenPtr &Token,
+                          FGitlabIntegrationIAPIDecodedCallback Callback) {
+    const bool bVerify = bVerifyJsonDecoder;
+    DecodeResponseWith(Response, Token, [bVerify](const FString &Url, const TArray<uint8> &Content) {
+        TGitlabIntegrationIAPIDecodedArray<StructType> *Parsed = new TGitlabIntegrationIAPIDecodedArray<StructType>();
+        if (!FGitlabIntegrationIAPIJsonDecoder::DecodeArray(Content, Parsed->Items)) {
+            UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Streaming decode of %s failed, using the Json converter"), *Url);
+            Parsed->Items.Empty();
+            FGitlabIntegrationIAPIJsonDecoder::DecodeArrayWithReflection(Content, Parsed->Items);
+        } else if (bVerify) {
+            FString Mismatch;
+            if (!FGitlabIntegrationIAPIJsonDecoder::VerifyArrayParity(Content, Parsed->Items, Mismatch)) {
+                UE_LOG(LogGitlabIntegrationIAPI, Error, TEXT("Json decoder mismatch for %s: %s"), *Url, *Mismatch);
             }
         }
+        PrepareDecodedItems(Parsed->Items);
+        return Parsed;
+    }, MoveTemp(Callback));
+}
+
+/** The watermark of a changes request moves with every sync, such a url is never asked for again */
+static bool IsCacheableUrl(const FString &Url) {
+    return !Url.Contains(TEXT("updated_after="));
+}
+
+void IAPI::DecodeResponseWith(FHttpResponsePtr Response, const FGitlabIntegrationIAPICancellationTokenPtr &Token,
+                              FGitlabIntegrationIAPIDecoder Decoder, FGitlabIntegrationIAPIDecodedCallback Callback) {
+    if (!Response.IsValid()) {
+        Callback(nullptr, nullptr);
+        return;
     }
+    // A 304 gets a copy of the cached page, the merge moves out of it and the cached page stays intact
+    FGitlabIntegrationIAPICachedPayload CachedParsed;
+    TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> CachedContent;
+    if (Response->GetResponseCode() == EHttpResponseCodes::NotModified) {
+        FGitlabIntegrationIAPICacheEntry *Entry = ResponseCache.Find(Response->GetURL());
+        if (Entry == nullptr || (!Entry->Parsed.IsValid() && !Entry->Content.IsValid())) {
+            Callback(Response, nullptr);
+            return;
+        }
+        CachedParsed = Entry->Parsed;
+        CachedContent = Entry->Content;
+        CacheHits++;
+    } else {
+        CacheMisses++;
+    }
+    const bool bCacheableUrl = IsCacheableUrl(Response->GetURL());
+    const int32 DecodeId = NextDecodeId++;
+    FPendingDecode &Pending = PendingDecodes.Add(DecodeId);
+    Pending.Response = Response;
+    Pending.Token = Token;
+    Pending.Callback = MoveTemp(Callback);
+
+    // The task only sees the response and the queue, everything else stays on the game thread
+    TSharedPtr<TQueue<FGitlabIntegrationIAPIDecodedBody, EQueueMode::Mpsc>, ESPMode::ThreadSafe> Queue = DecodedBodies;
+    FFunctionGraphTask::CreateAndDispatchWhenReady([Response, CachedParsed, CachedContent, Queue, DecodeId, Decoder, bCacheableUrl]() {
+        // Only Body references the result, so it changes hands without touching the reference count
+        FGitlabIntegrationIAPIDecodedBody Body;
+        Body.DecodeId = DecodeId;
+        if (CachedParsed.IsValid()) {
+            Body.Parsed = MakeShareable(CachedParsed->Clone());
+        } else if (CachedContent.IsValid()) {
+            Body.Parsed = MakeShareable(Decoder(Response->GetURL(), *CachedContent));
+        } else {
+            Body.Parsed = MakeShareable(Decoder(Response->GetURL(), Response->GetContent()));
+            const bool bCacheable = bCacheableUrl &&
+                (!Response->GetHeader(TEXT("ETag")).IsEmpty() || !Response->GetHeader(TEXT("Last-Modified")).IsEmpty());
+            if (bCacheable && Body.Parsed.IsValid()) {
+                Body.CacheCopy = MakeShareable(Body.Parsed->Clone());
+            }
+        }
+        Queue->Enqueue(MoveTemp(Body));
+    }, TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
 
-    int current_page = FCString::Atoi(*Response->GetHeader(TEXT("X-Page")));
-    int next_page = FCString::Atoi(*Response->GetHeader(TEXT("X-Next-Page")));
+    if (!DecodeTickHandle.IsValid()) {
+        DecodeTickHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &IAPI::ApplyDecodedBodies));
+    }
+}
 
-    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Current page: %d"), current_page)
-    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Next page: %d"), next_page)
+bool IAPI::ApplyDecodedBodies(float DeltaTime) {
+    FGitlabIntegrationIAPIDecodedBody Body;
+    while (DecodedBodies->Dequeue(Body)) {
+        FPendingDecode Pending;
+        if (!PendingDecodes.RemoveAndCopyValue(Body.DecodeId, Pending)) continue;
+        if (Pending.Token.IsValid() && Pending.Token->bCancelled) continue;
+        if (Pending.Response->GetResponseCode() != EHttpResponseCodes::NotModified) {
+            StoreResponse(Pending.Response, MoveTemp(Body.CacheCopy));
+        }
+        Pending.Callback(Pending.Response, Body.Parsed);
+    }
+    if (PendingDecodes.Num() == 0) {
+        DecodeTickHandle.Reset();
+        return false;
+    }
+    return true;
+}
 
-    if (next_page > current_page) {
-        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Trying to get next page of projects"));
-        GetProjectsRequest(next_page);
+void IAPI::StoreResponse(FHttpResponsePtr Response, FGitlabIntegrationIAPICachedPayload Parsed) {
+    const FString Url = Response->GetURL();
+    FString ETag = Response->GetHeader(TEXT("ETag"));
+    FString LastModified = Response->GetHeader(TEXT("Last-Modified"));
+    if ((ETag.IsEmpty() && LastModified.IsEmpty()) || !IsCacheableUrl(Url)) {
+        ResponseCache.Remove(Url);
     } else {
+        FGitlabIntegrationIAPICacheEntry &Entry = ResponseCache.FindOrAdd(Url);
+        Entry.ETag = ETag;
+        Entry.LastModified = LastModified;
+        // A decoded page replaces the body, single objects decoded on the game thread keep the body
+        Entry.Parsed = MoveTemp(Parsed);
+        if (Entry.Parsed.IsValid()) {
+            Entry.Content.Reset();
+        } else {
+            Entry.Content = MakeShareable(new TArray<uint8>(Response->GetContent()));
+        }
+        Entry.Headers.Empty();
+        for (const TCHAR *Header : {TEXT("X-Page"), TEXT("X-Next-Page"), TEXT("X-Total-Pages"), TEXT("X-Total")}) {
+            Entry.Headers.Add(Header, Response->GetHeader(Header));
+        }
+    }
+}
+
+void IAPI::GetProjectsRequest(int32 page, int32 serial) {
+    if (IsGroupMode()) {
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = GetRequest(
+            GetGroupRoute() + TEXT("/projects?simple=true&include_subgroups=true&archived=false"), page);
+        Request->OnProcessRequestComplete().BindRaw(this, &IAPI::ProjectsResponse, page, serial);
+        Send(Request, ProjectsFetch.Priority, ProjectToken);
+        return;
+    }
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = GetRequest("projects?simple=true", page);
+    Request->OnProcessRequestComplete().BindRaw(this, &IAPI::ProjectsResponse, page, serial);
+    Send(Request, ProjectsFetch.Priority, ServerToken);
+}
+
+void IAPI::ProjectsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int32 page, int32 serial) {
+    if (serial != ProjectsFetch.Serial) return;
+    if (!ResponseIsValid(Response, bWasSuccessful)) Response = nullptr;
 
+    DecodeResponse<FGitlabIntegrationIAPIProject>(Response, IsGroupMode() ? ProjectToken : ServerToken,
+        [this, page, serial](FHttpResponsePtr Decoded, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed) {
+            ProjectsDecoded(Decoded, Parsed, page, serial);
+        });
+}
+
+void IAPI::ProjectsDecoded(FHttpResponsePtr Response, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed, int32 page, int32 serial) {
+    // The fetch may have been restarted while the page was decoded
+    if (serial != ProjectsFetch.Serial) return;
+
+    bool Finished = HandlePage(ProjectsFetch, page, Response, Parsed,
+                               [this, serial](int32 NextPage) { GetProjectsRequest(NextPage, serial); },
+                               [this](FGitlabIntegrationIAPIDecodedPayload &Page) { MergeProjectsPage(Page); });
+
+    if (!Response.IsValid()) {
+        bProjectFetchFailed = true;
+    }
+    if (Finished) {
+        bProjectsLoaded = true;
+        if (IsGroupMode()) {
+            StartGroupPartitions();
+        }
+        if (ProjectCallback) {
+            ProjectCallback();
+        }
         UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Got list of projects"));
         for (auto &Project : Projects) {
             UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT(" %s"), *(Project.Value).name);
@@ -130,162 +533,690 @@ void IAPI::ProjectsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response,
     }
 }
 
-TArray<FGitlabIntegrationIAPIProject> IAPI::GetProjects() {
-    TArray<FGitlabIntegrationIAPIProject> result;
-    Projects.GenerateValueArray(result);
-    result.Sort([](const FGitlabIntegrationIAPIProject &One, const FGitlabIntegrationIAPIProject &Two) {
-        return One.name_with_namespace.Compare(Two.name_with_namespace, ESearchCase::IgnoreCase) < 0;
-    });
+void IAPI::MergeProjectsPage(FGitlabIntegrationIAPIDecodedPayload &Page) {
+    for (auto &Project : static_cast<TGitlabIntegrationIAPIDecodedArray<FGitlabIntegrationIAPIProject> &>(Page).Items) {
+        SeenProjectIds.Add(Project.id);
+        Projects.Add(Project.id, Project);
+    }
+    ProjectsVersion++;
 
-    return result;
+    if (ProjectCallback) {
+        ProjectCallback();
+    }
+}
+
+void IAPI::StartGroupPartitions() {
+    if (!bProjectFetchFailed) {
+        TArray<int32> Gone;
+        for (const auto &Project : Projects) {
+            if (!SeenProjectIds.Contains(Project.Key)) Gone.Add(Project.Key);
+        }
+        for (const auto &Partition : Partitions) {
+            if (!SeenProjectIds.Contains(Partition.Key)) Gone.AddUnique(Partition.Key);
+        }
+        for (int32 ProjectId : Gone) {
+            Projects.Remove(ProjectId);
+            RemovePartition(ProjectId);
+        }
+        if (Gone.Num() > 0) {
+            ProjectsVersion++;
+        }
+    }
+
+    // Every project is fetched on its own, so each gets its own page count and watermark and the
+    // scheduler interleaves them up to its request limit
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Loading issues of %d projects of %s"), Projects.Num(), *GroupPath);
+    TArray<int32> ProjectIds;
+    Projects.GenerateKeyArray(ProjectIds);
+    for (int32 ProjectId : ProjectIds) {
+        FetchPartitionIssues(ProjectId, ProjectsFetch.Priority, bIncrementalSync);
+    }
+}
+
+const TArray<TSharedPtr<FGitlabIntegrationIAPIProject>> &IAPI::GetProjects() {
+    if (SortedProjectsVersion != ProjectsVersion) {
+        // New objects, whoever still holds the previous projection keeps seeing the old data
+        SortedProjects.Reset(Projects.Num());
+        for (auto &Project : Projects) {
+            SortedProjects.Add(MakeShared<FGitlabIntegrationIAPIProject>(Project.Value));
+        }
+        SortedProjects.Sort([](const TSharedPtr<FGitlabIntegrationIAPIProject> &One, const TSharedPtr<FGitlabIntegrationIAPIProject> &Two) {
+            return One->name_with_namespace.Compare(Two->name_with_namespace, ESearchCase::IgnoreCase) < 0;
+        });
+        SortedProjectsVersion = ProjectsVersion;
+    }
+    return SortedProjects;
 }
 
 void IAPI::SetProject(FGitlabIntegrationIAPIProject project) {
+    if (IsGroupMode()) {
+        // The group store stays, the selected project only narrows down the view
+        SelectedProject = project;
+        return;
+    }
+    // Pages of the previous project still on their way would otherwise be merged into this one
+    CancelProjectRequests();
     SelectedProject = project;
     UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Project Last Activity: %s"), *project.last_activity_at.ToHttpDate());
+    ResetStore();
+    IssueWatermarks.Remove(project.id);
+    Partitions.Add(project.id);
+    // The watermark is gone, so this is a full load
+    FetchProjectContent();
+}
+
+void IAPI::ResetStore() {
+    StoreBaseUrl = ApiBaseUrl.ToString();
     Issues.Empty();
+    SearchIndex.Empty();
+    LabelIssueCounts.Reset();
     Labels.Empty();
     StringLabels.Empty();
-    GetProjectIssuesRequest(project.id, 1);
-    GetProjectLabels(project.id, 1);
+    IssuePool.Empty();
+    LabelPool.Empty();
+    Partitions.Empty();
+    FGitlabIntegrationIAPIIssueDelta IssueDelta;
+    IssueDelta.bReset = true;
+    PublishIssues(IssueDelta);
+    FGitlabIntegrationIAPILabelDelta LabelDelta;
+    LabelDelta.bReset = true;
+    PublishLabels(LabelDelta);
+}
+
+void IAPI::FetchProjectContent(EGitlabIntegrationIAPIRequestPriority Priority) {
+    if (IsGroupMode()) {
+        // The issues of each project follow once the project list of the group is in
+        FetchProjects(Priority);
+    } else {
+        RefreshIssues(Priority);
+    }
+    FetchProjectLabels(Priority);
+}
+
+void IAPI::FetchProjectIssues(EGitlabIntegrationIAPIRequestPriority Priority) {
+    TArray<int32> ProjectIds;
+    Partitions.GenerateKeyArray(ProjectIds);
+    for (int32 ProjectId : ProjectIds) {
+        FetchPartitionIssues(ProjectId, Priority, false);
+    }
 }
 
-void IAPI::GetProjectLabels(int project_id, int32 page) {
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = GetRequest("projects/" + FString::FromInt(project_id) + "/labels", page);
-    Request->OnProcessRequestComplete().BindRaw(this, &IAPI::ProjectLabelsResponse);
-    Send(Request);
+void IAPI::FetchProjectIssueChanges(EGitlabIntegrationIAPIRequestPriority Priority) {
+    TArray<int32> ProjectIds;
+    Partitions.GenerateKeyArray(ProjectIds);
+    for (int32 ProjectId : ProjectIds) {
+        FetchPartitionIssues(ProjectId, Priority, true);
+    }
+}
+
+void IAPI::FetchPartitionIssues(int32 ProjectId, EGitlabIntegrationIAPIRequestPriority Priority, bool bChanges) {
+    FGitlabIntegrationIAPIIssuePartition &Partition = Partitions.FindOrAdd(ProjectId);
+    Partition.Fetch.Restart(Priority);
+    // Unique over all partitions, a partition dropped and added again must not take the old responses
+    Partition.Fetch.Serial = ++IssueFetchSerial;
+    Partition.bLoading = true;
+    FDateTime *Watermark = IssueWatermarks.Find(ProjectId);
+    if (!bChanges || Watermark == nullptr) {
+        Partition.PendingWatermark = FDateTime::FromUnixTimestamp(0);
+        Partition.bFull = true;
+        Partition.SeenIds.Empty();
+        GetProjectIssuesRequest(ProjectId, TEXT("state=opened"), 1, Partition.Fetch.Serial);
+        return;
+    }
+    Partition.PendingWatermark = *Watermark;
+    Partition.bFull = false;
+    // state=all so that closed issues come back too and can be dropped
+    GetProjectIssuesRequest(ProjectId,
+                            TEXT("state=all&updated_after=") + FPlatformHttp::UrlEncode(Watermark->ToIso8601()),
+                            1, Partition.Fetch.Serial);
+}
+
+void IAPI::RemovePartition(int32 ProjectId) {
+    FGitlabIntegrationIAPIIssuePartition Partition;
+    if (!Partitions.RemoveAndCopyValue(ProjectId, Partition)) return;
+    IssueWatermarks.Remove(ProjectId);
+    FGitlabIntegrationIAPIIssueDelta Delta;
+    for (int32 IssueId : Partition.IssueIds) {
+        TSharedPtr<FGitlabIntegrationIAPIIssue> Removed;
+        if (Issues.RemoveAndCopyValue(IssueId, Removed)) {
+            SearchIndex.Remove(IssueId);
+            CountIssueLabels(*Removed, -1);
+            Delta.Removed.Add(Removed);
+        }
+    }
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Project %d left the group, dropped %d issues"), ProjectId, Delta.Removed.Num());
+    PublishIssues(Delta);
 }
 
-void IAPI::GetProjectIssuesRequest(int project_id, int32 page) {
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = GetRequest("projects/" + FString::FromInt(project_id) + "/issues?state=opened", page);
-    Request->OnProcessRequestComplete().BindRaw(this, &IAPI::ProjectIssuesResponse);
-    Send(Request);
+FString IAPI::GetGroupRoute() const {
+    return TEXT("groups/") + FPlatformHttp::UrlEncode(GroupPath);
+}
+
+void IAPI::FetchProjectLabels(EGitlabIntegrationIAPIRequestPriority Priority) {
+    LabelsFetch.Restart(Priority);
+    bLabelFetchFailed = false;
+    SeenLabelIds.Empty();
+    GetProjectLabels(SelectedProject.id, 1, LabelsFetch.Serial);
+}
+
+void IAPI::GetProjectLabels(int project_id, int32 page, int32 serial) {
+    // Group labels are shared by all projects of the group, labels of a single project are not among them
+    const FString Route = IsGroupMode() ? GetGroupRoute() + TEXT("/labels") : "projects/" + FString::FromInt(project_id) + "/labels";
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = GetRequest(Route, page);
+    Request->OnProcessRequestComplete().BindRaw(this, &IAPI::ProjectLabelsResponse, project_id, page, serial);
+    Send(Request, LabelsFetch.Priority, ProjectToken);
+}
+
+void IAPI::GetProjectIssuesRequest(int project_id, FString query, int32 page, int32 serial) {
+    const FGitlabIntegrationIAPIIssuePartition *Partition = Partitions.Find(project_id);
+    if (Partition == nullptr) return;
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = GetRequest("projects/" + FString::FromInt(project_id) + "/issues?" + query, page);
+    Request->OnProcessRequestComplete().BindRaw(this, &IAPI::ProjectIssuesResponse, project_id, query, page, serial);
+    Send(Request, Partition->Fetch.Priority, ProjectToken);
 }
 
 FGitlabIntegrationIAPIProject IAPI::GetProject() {
     return SelectedProject;
 }
 
-void IAPI::ProjectIssuesResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful) {
-    if (!ResponseIsValid(Response, bWasSuccessful)) return;
+void IAPI::ProjectIssuesResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int project_id, FString query, int32 page, int32 serial) {
+    const FGitlabIntegrationIAPIIssuePartition *Partition = Partitions.Find(project_id);
+    if (Partition == nullptr || serial != Partition->Fetch.Serial) return;
+    if (!ResponseIsValid(Response, bWasSuccessful)) Response = nullptr;
+
+    DecodeResponse<FGitlabIntegrationIAPIIssue>(Response, ProjectToken,
+        [this, project_id, query, page, serial](FHttpResponsePtr Decoded, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed) {
+            ProjectIssuesDecoded(Decoded, Parsed, project_id, query, page, serial);
+        });
+}
 
-    TArray<FGitlabIntegrationIAPIIssue> LocalIssues;
-    FString JsonString = Response->GetContentAsString();
-    FJsonObjectConverter::JsonArrayStringToUStruct(JsonString, &LocalIssues, 0, 0);
+void IAPI::ProjectIssuesDecoded(FHttpResponsePtr Response, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed, int project_id, FString query, int32 page, int32 serial) {
+    // Merges never add or remove partitions, the pointer stays valid
+    FGitlabIntegrationIAPIIssuePartition *Partition = Partitions.Find(project_id);
+    if (Partition == nullptr || serial != Partition->Fetch.Serial) return;
 
-    for (auto &Issue : LocalIssues) {
-        if (!Issues.Contains(Issue.id)) {
-            TSharedPtr<FGitlabIntegrationIAPIIssue> TempIssue = MakeShareable(new FGitlabIntegrationIAPIIssue(Issue));
-            Issues.Emplace(Issue.id, TempIssue);
-        }
+    bool Failed = !Response.IsValid();
+    bool Finished = HandlePage(Partition->Fetch, page, Response, Parsed,
+                               [this, project_id, query, serial](int32 NextPage) { GetProjectIssuesRequest(project_id, query, NextPage, serial); },
+                               [this, Partition](FGitlabIntegrationIAPIDecodedPayload &Page) { MergeIssuesPage(*Partition, Page); });
+
+    if (Failed) {
+        FailIssueFetch(project_id);
+    }
+    if (Finished) {
+        CompleteIssueFetch(project_id);
     }
+}
+
+void IAPI::FailIssueFetch(int project_id) {
+    IssueWatermarks.Remove(project_id);
+    if (FGitlabIntegrationIAPIIssuePartition *Partition = Partitions.Find(project_id)) {
+        Partition->PendingWatermark = FDateTime::MaxValue();
+    }
+}
 
-    int current_page = FCString::Atoi(*Response->GetHeader(TEXT("X-Page")));
-    int next_page = FCString::Atoi(*Response->GetHeader(TEXT("X-Next-Page")));
+void IAPI::CompleteIssueFetch(int project_id) {
+    FGitlabIntegrationIAPIIssuePartition *Partition = Partitions.Find(project_id);
+    if (Partition == nullptr) return;
+    Partition->bLoading = false;
+    if (Partition->PendingWatermark < FDateTime::MaxValue()) {
+        IssueWatermarks.Add(project_id, Partition->PendingWatermark);
+        if (Partition->bFull) {
+            // Only this project's issues are looked at, the other partitions reconcile on their own
+            FGitlabIntegrationIAPIIssueDelta Delta;
+            for (auto It = Partition->IssueIds.CreateIterator(); It; ++It) {
+                if (Partition->SeenIds.Contains(*It)) continue;
+                TSharedPtr<FGitlabIntegrationIAPIIssue> Removed;
+                if (Issues.RemoveAndCopyValue(*It, Removed)) {
+                    SearchIndex.Remove(*It);
+                    CountIssueLabels(*Removed, -1);
+                    Delta.Removed.Add(Removed);
+                }
+                It.RemoveCurrent();
+            }
+            Partition->SeenIds.Empty();
+            PublishIssues(Delta);
+        }
+    }
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Got issues of project %d, updated until %s"), project_id,
+           *Partition->PendingWatermark.ToIso8601());
 
-    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Current page: %d"), current_page)
-    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Next page: %d"), next_page)
+    for (const auto &Other : Partitions) {
+        if (Other.Value.bLoading) return;
+    }
+    // Written once after the last partition rather than after each project of a group
+    SaveCache();
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Got list of issues, %d in %d projects"), Issues.Num(), Partitions.Num());
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Response cache: %d hits, %d misses"), CacheHits, CacheMisses);
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Issues: %d created in %d slabs (%d slabs allocated so far), %d updated in place"),
+           IssuesAllocated, IssuePool.GetSlabCount(), IssuePool.SlabsAllocated, IssuesUpdatedInPlace);
+    Scheduler.LogStats();
+    for (auto &Issue : Issues) {
+        UE_LOG(LogGitlabIntegrationIAPI, Verbose, TEXT(" %s"), *(Issue.Value)->title);
+    }
+}
 
-    if(IssueCallback) {
-        IssueCallback();
+void IAPI::MergeIssuesPage(FGitlabIntegrationIAPIIssuePartition &Partition, FGitlabIntegrationIAPIDecodedPayload &Page) {
+    TArray<FGitlabIntegrationIAPIIssue> &Items = static_cast<TGitlabIntegrationIAPIDecodedArray<FGitlabIntegrationIAPIIssue> &>(Page).Items;
+    for (const auto &Issue : Items) {
+        if (Partition.PendingWatermark < Issue.updated_at && Partition.PendingWatermark < FDateTime::MaxValue()) {
+            Partition.PendingWatermark = Issue.updated_at;
+        }
+        Partition.SeenIds.Add(Issue.id);
     }
+    MergeIssues(Items);
+}
 
-    if (next_page > current_page) {
-        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Trying to get next page of issues"));
-        GetProjectIssuesRequest(SelectedProject.id, next_page);
-    } else {
-        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Got list of issues"));
-        for (auto &Issue : Issues) {
-            UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT(" %s"), *(Issue.Value)->title);
+void IAPI::MergeIssues(TArray<FGitlabIntegrationIAPIIssue> &Items) {
+    FGitlabIntegrationIAPIIssueDelta Delta;
+    for (auto &Issue : Items) {
+        TSharedPtr<FGitlabIntegrationIAPIIssue> *Existing = Issues.Find(Issue.id);
+        if (!Issue.state.Equals(TEXT("opened"), ESearchCase::IgnoreCase)) {
+            if (Existing != nullptr) {
+                if (FGitlabIntegrationIAPIIssuePartition *Partition = Partitions.Find((*Existing)->project_id)) {
+                    Partition->IssueIds.Remove(Issue.id);
+                }
+                Delta.Removed.Add(*Existing);
+                CountIssueLabels(**Existing, -1);
+                Issues.Remove(Issue.id);
+                SearchIndex.Remove(Issue.id);
+            }
+        } else if (Existing != nullptr) {
+            // Update in place so that everyone holding the pointer sees the change, the page is not needed afterwards
+            FGitlabIntegrationIAPIIssue &Stored = **Existing;
+            CountIssueLabels(Stored, -1);
+            Stored = MoveTemp(Issue);
+            InternIssueLabels(Stored);
+            CountIssueLabels(Stored, 1);
+            SearchIndex.Add(Stored.id, Stored.iid, Stored.title);
+            Delta.Updated.Add(*Existing);
+            IssuesUpdatedInPlace++;
+        } else {
+            // Moved into the current slab, the strings come from the page without a copy
+            TSharedPtr<FGitlabIntegrationIAPIIssue> TempIssue = IssuePool.Add(MoveTemp(Issue));
+            InternIssueLabels(*TempIssue);
+            CountIssueLabels(*TempIssue, 1);
+            Issues.Emplace(TempIssue->id, TempIssue);
+            SearchIndex.Add(TempIssue->id, TempIssue->iid, TempIssue->title);
+            if (FGitlabIntegrationIAPIIssuePartition *Partition = Partitions.Find(TempIssue->project_id)) {
+                Partition->IssueIds.Add(TempIssue->id);
+            }
+            Delta.Added.Add(TempIssue);
+            IssuesAllocated++;
         }
     }
+
+    PublishIssues(Delta);
 }
 
-void IAPI::ProjectLabelsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful) {
-    if (!ResponseIsValid(Response, bWasSuccessful)) return;
+void IAPI::ProjectLabelsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int project_id, int32 page, int32 serial) {
+    if (serial != LabelsFetch.Serial) return;
+    if (!ResponseIsValid(Response, bWasSuccessful)) Response = nullptr;
+
+    DecodeResponse<FGitlabIntegrationIAPILabel>(Response, ProjectToken,
+        [this, project_id, page, serial](FHttpResponsePtr Decoded, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed) {
+            ProjectLabelsDecoded(Decoded, Parsed, project_id, page, serial);
+        });
+}
 
-    TArray<FGitlabIntegrationIAPILabel> LocalLabels;
-    FString JsonString = Response->GetContentAsString();
-    FJsonObjectConverter::JsonArrayStringToUStruct(JsonString, &LocalLabels, 0, 0);
+void IAPI::ProjectLabelsDecoded(FHttpResponsePtr Response, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed, int project_id, int32 page, int32 serial) {
+    if (serial != LabelsFetch.Serial) return;
 
-    for (auto &Label : LocalLabels) {
-        if (!Labels.Contains(Label.id)) {
+    bool Finished = HandlePage(LabelsFetch, page, Response, Parsed,
+                               [this, project_id, serial](int32 NextPage) { GetProjectLabels(project_id, NextPage, serial); },
+                               [this](FGitlabIntegrationIAPIDecodedPayload &Page) { MergeLabelsPage(Page); });
 
-            TSharedPtr<FGitlabIntegrationIAPILabel> TempLabel= MakeShareable(new FGitlabIntegrationIAPILabel(Label));
-            Labels.Emplace(Label.id, TempLabel);
-            StringLabels.Emplace(Label.name, TempLabel);
+    if (!Response.IsValid()) {
+        bLabelFetchFailed = true;
+    }
+    if (Finished) {
+        CompleteLabelFetch();
+    }
+}
+
+void IAPI::CompleteLabelFetch() {
+    if (!bLabelFetchFailed) {
+        FGitlabIntegrationIAPILabelDelta Delta;
+        for (auto It = Labels.CreateIterator(); It; ++It) {
+            if (!SeenLabelIds.Contains(It.Key())) {
+                StringLabels.Remove(It.Value()->name);
+                Delta.Removed.Add(It.Value());
+                It.RemoveCurrent();
+            }
+        }
+        PublishLabels(Delta);
+    }
+    SaveCache();
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Got list of labels"));
+    for (auto &Label : Labels) {
+        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT(" %s"), *(Label.Value)->name);
+    }
+}
+
+void IAPI::MergeLabelsPage(FGitlabIntegrationIAPIDecodedPayload &Page) {
+    TArray<FGitlabIntegrationIAPILabel> &Items = static_cast<TGitlabIntegrationIAPIDecodedArray<FGitlabIntegrationIAPILabel> &>(Page).Items;
+    for (const auto &Label : Items) {
+        SeenLabelIds.Add(Label.id);
+    }
+    MergeLabels(Items);
+}
+
+void IAPI::MergeLabels(TArray<FGitlabIntegrationIAPILabel> &Items) {
+    FGitlabIntegrationIAPILabelDelta Delta;
+    for (auto &Label : Items) {
+        TSharedPtr<FGitlabIntegrationIAPILabel> *Existing = Labels.Find(Label.id);
+        if (Existing != nullptr) {
+            if ((*Existing)->HasSameContent(Label)) continue;
+            StringLabels.Remove((*Existing)->name);
+            // Colors were parsed by the decode task or the webhook receiver
+            **Existing = MoveTemp(Label);
+            (*Existing)->InternId = InternLabel((*Existing)->name);
+            StringLabels.Emplace((*Existing)->name, *Existing);
+            Delta.Updated.Add(*Existing);
+        } else {
+            TSharedPtr<FGitlabIntegrationIAPILabel> TempLabel = LabelPool.Add(MoveTemp(Label));
+            TempLabel->InternId = InternLabel(TempLabel->name);
+            Labels.Emplace(TempLabel->id, TempLabel);
+            StringLabels.Emplace(TempLabel->name, TempLabel);
+            Delta.Added.Add(TempLabel);
         }
     }
 
-    int current_page = FCString::Atoi(*Response->GetHeader(TEXT("X-Page")));
-    int next_page = FCString::Atoi(*Response->GetHeader(TEXT("X-Next-Page")));
+    PublishLabels(Delta);
+}
 
-    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Current page: %d"), current_page)
-    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Next page: %d"), next_page)
+void IAPI::PollProjectActivity(std::function<void(bool)> Callback) {
+    // No cancellation token, the response is checked against the selected project and the callback must run
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = GetRequest(FString::Printf(TEXT("projects/%d"), SelectedProject.id), 0);
+    Request->OnProcessRequestComplete().BindRaw(this, &IAPI::ProjectActivityResponse, Callback);
+    Send(Request, EGitlabIntegrationIAPIRequestPriority::Background);
+}
 
-    if(LabelCallback) {
-        LabelCallback();
+void IAPI::ProjectActivityResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, std::function<void(bool)> Callback) {
+    bool bActivity = false;
+    // A 304 means nothing changed, without even a body to parse
+    if (ResponseIsValid(Response, bWasSuccessful) && Response->GetResponseCode() != EHttpResponseCodes::NotModified) {
+        StoreResponse(Response);
+        FGitlabIntegrationIAPIProject Project;
+        GetStructFromJsonString<FGitlabIntegrationIAPIProject>(Response, Project);
+        if (Project.id != -1 && Project.id == SelectedProject.id && Project.last_activity_at != SelectedProject.last_activity_at) {
+            UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Project activity at %s, syncing issues"), *Project.last_activity_at.ToIso8601());
+            SelectedProject.last_activity_at = Project.last_activity_at;
+            Projects.Add(Project.id, Project);
+            ProjectsVersion++;
+            RefreshIssues(EGitlabIntegrationIAPIRequestPriority::Background);
+            bActivity = true;
+        }
     }
+    Callback(bActivity);
+}
 
-    if (next_page > current_page) {
-        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Trying to get next page of labels"));
-        GetProjectLabels(SelectedProject.id, next_page);
-    } else {
-        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Got list of labels"));
-        for (auto &Label : Labels) {
-            UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT(" %s"), *(Label.Value)->name);
+void IAPI::ApplyIssueEvent(FGitlabIntegrationIAPIIssue Issue, TArray<FGitlabIntegrationIAPILabel> EventLabels) {
+    if (!Partitions.Contains(Issue.project_id)) {
+        UE_LOG(LogGitlabIntegrationIAPI, Verbose, TEXT("Ignoring event for issue %d of project %d"), Issue.id, Issue.project_id);
+        return;
+    }
+    if (IsGroupMode()) {
+        // Group labels are all the group fetch lists, a project-only label added here would be pruned by the next one
+        EventLabels.RemoveAll([this](const FGitlabIntegrationIAPILabel &Label) { return !Labels.Contains(Label.id); });
+    }
+    for (FGitlabIntegrationIAPILabel &Label : EventLabels) {
+        // Older Gitlab versions leave text_color out of webhooks, that alone is no change
+        if (Label.text_color.IsEmpty()) {
+            const TSharedPtr<FGitlabIntegrationIAPILabel> *Existing = Labels.Find(Label.id);
+            Label.text_color = Existing != nullptr ? (*Existing)->text_color : TEXT("#FFFFFF");
         }
+        ParseLabelColors(Label);
     }
+    // Labels first, the issue row looks its labels up by name
+    MergeLabels(EventLabels);
+    TArray<FGitlabIntegrationIAPIIssue> Items;
+    Items.Add(MoveTemp(Issue));
+    MergeIssues(Items);
 }
 
-void IAPI::SetIssueCallback(std::function<void()> callback) {
+void IAPI::PublishIssues(const FGitlabIntegrationIAPIIssueDelta &Delta) {
+    if (Delta.IsEmpty()) return;
+    IssuesVersion++;
+    if (IssueCallback) {
+        IssueCallback(Delta);
+    }
+}
+
+void IAPI::PublishLabels(const FGitlabIntegrationIAPILabelDelta &Delta) {
+    if (Delta.IsEmpty()) return;
+    LabelsVersion++;
+    if (LabelCallback) {
+        LabelCallback(Delta);
+    }
+}
+
+void IAPI::SetCacheFile(FString Filename) {
+    CacheFile = Filename;
+}
+
+void IAPI::SaveCache() {
+    if (CacheFile.IsEmpty() || (SelectedProject.id == -1 && !IsGroupMode())) return;
+    // Saved under the current server, which must be the one the store was loaded from
+    if (StoreBaseUrl != ApiBaseUrl.ToString()) return;
+
+    TArray<uint8> Data;
+    FMemoryWriter Ar(Data);
+    uint32 Magic = GITLAB_INTEGRATION_CACHE_MAGIC;
+    int32 Version = CacheFileVersion;
+    FString BaseUrl = ApiBaseUrl.ToString();
+    Ar << Magic << Version << BaseUrl << GroupPath << SelectedProject << Projects << IssueWatermarks;
+
+    int32 IssueCount = Issues.Num();
+    Ar << IssueCount;
+    for (auto &Issue : Issues) {
+        Ar << *Issue.Value;
+    }
+    int32 LabelCount = Labels.Num();
+    Ar << LabelCount;
+    for (auto &Label : Labels) {
+        Ar << *Label.Value;
+    }
+
+    if (!FFileHelper::SaveArrayToFile(Data, *CacheFile)) {
+        UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Failed to write cache %s"), *CacheFile);
+    }
+}
+
+bool IAPI::LoadCache() {
+    TArray<uint8> Data;
+    if (CacheFile.IsEmpty() || !FFileHelper::LoadFileToArray(Data, *CacheFile, FILEREAD_Silent)) return false;
+
+    FMemoryReader Ar(Data);
+    uint32 Magic = 0;
+    int32 Version = 0;
+    FString BaseUrl;
+    Ar << Magic << Version;
+    if (Magic != GITLAB_INTEGRATION_CACHE_MAGIC || Version != CacheFileVersion) {
+        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Ignoring cache %s with version %d"), *CacheFile, Version);
+        return false;
+    }
+
+    FString CachedGroup;
+    FGitlabIntegrationIAPIProject CachedProject;
+    Ar << BaseUrl << CachedGroup << CachedProject;
+    bool SameProject = InitialProjectId > 0 ? CachedProject.id == InitialProjectId
+                                            : CachedProject.name_with_namespace == InitialProjectName.ToString();
+    // A group cache holds the whole group, whichever project narrows down the view
+    if (BaseUrl != ApiBaseUrl.ToString() || CachedGroup != GroupPath || (!IsGroupMode() && !SameProject)) {
+        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Cache %s belongs to a different server or project"), *CacheFile);
+        return false;
+    }
+
+    TMap<int32, FGitlabIntegrationIAPIProject> CachedProjects;
+    TMap<int32, FDateTime> CachedWatermarks;
+    TArray<FGitlabIntegrationIAPIIssue> CachedIssues;
+    TArray<FGitlabIntegrationIAPILabel> CachedLabels;
+    Ar << CachedProjects << CachedWatermarks << CachedIssues << CachedLabels;
+    if (Ar.IsError()) {
+        UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Cache %s is corrupted"), *CacheFile);
+        return false;
+    }
+
+    SelectedProject = CachedProject;
+    StoreBaseUrl = BaseUrl;
+    Projects = MoveTemp(CachedProjects);
+    ProjectsVersion++;
+    IssueWatermarks = MoveTemp(CachedWatermarks);
+    FGitlabIntegrationIAPIIssueDelta IssueDelta;
+    IssueDelta.bReset = true;
+    Issues.Empty(CachedIssues.Num());
+    IssuePool.Empty();
+    SearchIndex.Empty();
+    LabelIssueCounts.Reset();
+    Partitions.Empty();
+    if (!IsGroupMode()) {
+        Partitions.Add(SelectedProject.id);
+    }
+    for (auto &Issue : CachedIssues) {
+        InternIssueLabels(Issue);
+        CountIssueLabels(Issue, 1);
+        TSharedPtr<FGitlabIntegrationIAPIIssue> TempIssue = IssuePool.Add(MoveTemp(Issue));
+        Issues.Emplace(TempIssue->id, TempIssue);
+        SearchIndex.Add(TempIssue->id, TempIssue->iid, TempIssue->title);
+        Partitions.FindOrAdd(TempIssue->project_id).IssueIds.Add(TempIssue->id);
+        IssueDelta.Added.Add(TempIssue);
+    }
+    FGitlabIntegrationIAPILabelDelta LabelDelta;
+    LabelDelta.bReset = true;
+    Labels.Empty(CachedLabels.Num());
+    StringLabels.Empty(CachedLabels.Num());
+    LabelPool.Empty();
+    for (auto &Label : CachedLabels) {
+        PrepareLabel(Label);
+        TSharedPtr<FGitlabIntegrationIAPILabel> TempLabel = LabelPool.Add(MoveTemp(Label));
+        Labels.Emplace(TempLabel->id, TempLabel);
+        StringLabels.Emplace(TempLabel->name, TempLabel);
+        LabelDelta.Added.Add(TempLabel);
+    }
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Loaded %d issues and %d labels from %s"), Issues.Num(), Labels.Num(), *CacheFile);
+
+    if (ProjectCallback) {
+        ProjectCallback();
+    }
+    PublishIssues(IssueDelta);
+    PublishLabels(LabelDelta);
+
+    // Reconcile with the server in the background
+    FetchProjectContent(EGitlabIntegrationIAPIRequestPriority::Background);
+    return true;
+}
+
+void IAPI::SetIssueCallback(FGitlabIntegrationIAPIIssueCallback callback) {
     IssueCallback = callback;
 }
 
-void IAPI::SetLabelCallback(std::function<void()> callback) {
+void IAPI::SetLabelCallback(FGitlabIntegrationIAPILabelCallback callback) {
     LabelCallback = callback;
 }
 
-IAPI::IAPI(FText base, FText token, FText LoadProject, std::function<void()> IssueCallback, std::function<void()> LabelCallback) {
+IAPI::IAPI(FText base, FText token, FText LoadProject, FGitlabIntegrationIAPIIssueCallback IssueCallback, FGitlabIntegrationIAPILabelCallback LabelCallback) {
     UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Creating Gitlab API"));
     Http = &FHttpModule::Get();
     SetBaseUrl(base);
     ApiToken = token;
     InitialProjectName = LoadProject;
     SetIssueCallback(IssueCallback);
-    GetProjectsRequest(1);
 }
 
-TArray<TSharedPtr<FGitlabIntegrationIAPIIssue>> IAPI::GetIssues() {
-    TArray<TSharedPtr<FGitlabIntegrationIAPIIssue>> result;
-    Issues.GenerateValueArray(result);
-    return result;
+const TArray<TSharedPtr<FGitlabIntegrationIAPIIssue>> &IAPI::GetIssues() {
+    if (IssueArrayVersion != IssuesVersion) {
+        Issues.GenerateValueArray(IssueArray);
+        IssueArrayVersion = IssuesVersion;
+    }
+    return IssueArray;
+}
+
+bool IAPI::LabelLess(const TSharedPtr<FGitlabIntegrationIAPILabel> &A, const TSharedPtr<FGitlabIntegrationIAPILabel> &B) {
+    const int32 Compare = A->name.Compare(B->name, ESearchCase::IgnoreCase);
+    return Compare != 0 ? Compare < 0 : A->id < B->id;
 }
 
-TArray<TSharedPtr<FGitlabIntegrationIAPILabel>> IAPI::GetLabels() {
-    TArray<TSharedPtr<FGitlabIntegrationIAPILabel>> result;
-    Labels.GenerateValueArray(result);
-    return result;
+const TArray<TSharedPtr<FGitlabIntegrationIAPILabel>> &IAPI::GetLabels() {
+    if (SortedLabelsVersion != LabelsVersion) {
+        Labels.GenerateValueArray(SortedLabels);
+        SortedLabels.Sort(&IAPI::LabelLess);
+        SortedLabelsVersion = LabelsVersion;
+    }
+    return SortedLabels;
+}
+
+void IAPI::RefreshIssues(EGitlabIntegrationIAPIRequestPriority Priority) {
+    if (bIncrementalSync) {
+        FetchProjectIssueChanges(Priority);
+    } else {
+        FetchProjectIssues(Priority);
+    }
+}
+
+void IAPI::SetIncrementalSync(bool Incremental) {
+    bIncrementalSync = Incremental;
 }
 
-void IAPI::RefreshIssues() {
-    GetProjectIssuesRequest(SelectedProject.id,1);
+void IAPI::SetVerifyJsonDecoder(bool Verify) {
+    bVerifyJsonDecoder = Verify;
 }
 
 void IAPI::RecordTimeSpent(TSharedPtr <FGitlabIntegrationIAPIIssue> issue, int time) {
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = PostRequest(
         FString::Printf(TEXT("projects/%d/issues/%d/add_spent_time?duration=%ds"), issue->project_id, issue->iid, time),
         TEXT(""));
-    Request->OnProcessRequestComplete().BindRaw(this, &IAPI::ProjectsResponse);
-    Send(Request);
+    Request->OnProcessRequestComplete().BindRaw(this, &IAPI::TimeSpentResponse);
+    Send(Request, EGitlabIntegrationIAPIRequestPriority::Interactive);
 }
 
-TSharedPtr <FGitlabIntegrationIAPILabel> IAPI::GetLabel(FString &name) {
-    if (StringLabels.Contains(name)) {
-        return *(StringLabels.Find(name));
-    } else {
-        return MakeShareable(new FGitlabIntegrationIAPILabel());
+int32 IAPI::InternLabel(const FString &Name) {
+    if (const int32 *Id = LabelIds.Find(Name)) {
+        return *Id;
+    }
+    const int32 Id = LabelNames.Add(Name);
+    LabelIds.Add(Name, Id);
+    return Id;
+}
+
+const FString &IAPI::GetLabelName(int32 InternId) const {
+    static const FString NoName;
+    return LabelNames.IsValidIndex(InternId) ? LabelNames[InternId] : NoName;
+}
+
+void IAPI::InternIssueLabels(FGitlabIntegrationIAPIIssue &Issue) {
+    Issue.LabelIds.Reset();
+    for (const FString &Name : Issue.labels) {
+        Issue.LabelIds.Add(InternLabel(Name));
+    }
+    Issue.LabelIds.Sort();
+}
+
+void IAPI::CountIssueLabels(const FGitlabIntegrationIAPIIssue &Issue, int32 Change) {
+    for (int32 Id : Issue.LabelIds) {
+        if (LabelIssueCounts.Num() <= Id) {
+            LabelIssueCounts.SetNumZeroed(Id + 1);
+        }
+        LabelIssueCounts[Id] += Change;
+    }
+}
+
+void IAPI::PrepareLabel(FGitlabIntegrationIAPILabel &Label) {
+    Label.InternId = InternLabel(Label.name);
+    ParseLabelColors(Label);
+}
+
+void IAPI::ParseLabelColors(FGitlabIntegrationIAPILabel &Label) {
+    Label.Color = FLinearColor(FColor::FromHex(Label.color));
+    Label.TextColor = FLinearColor(FColor::FromHex(Label.text_color));
+}
+
+TSharedPtr <const FGitlabIntegrationIAPILabel> IAPI::GetLabel(const FString &name) {
+    static const TSharedPtr<const FGitlabIntegrationIAPILabel> Placeholder = MakeShareable(new FGitlabIntegrationIAPILabel());
+    if (const TSharedPtr<FGitlabIntegrationIAPILabel> *Label = StringLabels.Find(name)) {
+        return *Label;
     }
+    return Placeholder;
 }
 
 void IAPI::TimeSpentResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful) {
@@ -0,0 +1,355 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "../../Public/API/IAPIJsonReader.h"
+
+static void AppendUtf8(FString &Out, const uint8 *Start, int32 Length) {
+    if (Length > 0) {
+        FUTF8ToTCHAR Converted((const ANSICHAR *) Start, Length);
+        Out.AppendChars(Converted.Get(), Converted.Length());
+    }
+}
+
+static void AppendCodepoint(FString &Out, uint32 Codepoint) {
+    if (sizeof(TCHAR) == 2 && Codepoint > 0xFFFF) {
+        Codepoint -= 0x10000;
+        Out.AppendChar((TCHAR) (0xD800 + (Codepoint >> 10)));
+        Out.AppendChar((TCHAR) (0xDC00 + (Codepoint & 0x3FF)));
+    } else {
+        Out.AppendChar((TCHAR) Codepoint);
+    }
+}
+
+static bool ParseHex4(const uint8 *Start, const uint8 *End, uint32 &Out) {
+    if (End - Start < 4) return false;
+    Out = 0;
+    for (int32 Index = 0; Index < 4; Index++) {
+        uint8 Char = Start[Index];
+        Out <<= 4;
+        if (Char >= '0' && Char <= '9') Out |= Char - '0';
+        else if (Char >= 'a' && Char <= 'f') Out |= Char - 'a' + 10;
+        else if (Char >= 'A' && Char <= 'F') Out |= Char - 'A' + 10;
+        else return false;
+    }
+    return true;
+}
+
+FGitlabIntegrationIAPIJsonReader::FGitlabIntegrationIAPIJsonReader(const uint8 *InData, int32 InLength)
+    : Pos(InData), End(InData + InLength) {
+    // Skip the UTF-8 byte order mark
+    if (InLength >= 3 && InData[0] == 0xEF && InData[1] == 0xBB && InData[2] == 0xBF) {
+        Pos += 3;
+    }
+}
+
+bool FGitlabIntegrationIAPIJsonReader::Fail() {
+    bError = true;
+    Pos = End;
+    return false;
+}
+
+void FGitlabIntegrationIAPIJsonReader::SkipWhitespace() {
+    while (Pos < End && (*Pos == ' ' || *Pos == '\n' || *Pos == '\r' || *Pos == '\t')) {
+        Pos++;
+    }
+}
+
+bool FGitlabIntegrationIAPIJsonReader::Consume(uint8 Char) {
+    SkipWhitespace();
+    if (Pos < End && *Pos == Char) {
+        Pos++;
+        return true;
+    }
+    return false;
+}
+
+bool FGitlabIntegrationIAPIJsonReader::ConsumeLiteral(const ANSICHAR *Literal, int32 Length) {
+    if (End - Pos >= Length && FMemory::Memcmp(Pos, Literal, Length) == 0) {
+        Pos += Length;
+        return true;
+    }
+    return false;
+}
+
+bool FGitlabIntegrationIAPIJsonReader::ConsumeNull() {
+    SkipWhitespace();
+    return ConsumeLiteral("null", 4);
+}
+
+bool FGitlabIntegrationIAPIJsonReader::BeginArray() {
+    if (!Consume('[')) return Fail();
+    bFirst = true;
+    return true;
+}
+
+bool FGitlabIntegrationIAPIJsonReader::BeginObject() {
+    if (!Consume('{')) return Fail();
+    bFirst = true;
+    return true;
+}
+
+bool FGitlabIntegrationIAPIJsonReader::NextElement() {
+    if (bError) return false;
+    if (Consume(']')) {
+        bFirst = false;
+        return false;
+    }
+    if (!bFirst && !Consume(',')) return Fail();
+    bFirst = false;
+    return true;
+}
+
+bool FGitlabIntegrationIAPIJsonReader::NextKey() {
+    if (bError) return false;
+    if (Consume('}')) {
+        bFirst = false;
+        return false;
+    }
+    if (!bFirst && !Consume(',')) return Fail();
+    bFirst = false;
+
+    if (!Consume('"')) return Fail();
+    bool bEscaped, bAscii;
+    // Gitlab keys are plain ascii, they are compared raw
+    if (!ScanString(KeyStart, KeyLength, bEscaped, bAscii)) return false;
+    if (!Consume(':')) return Fail();
+    return true;
+}
+
+bool FGitlabIntegrationIAPIJsonReader::ScanString(const uint8 *&Start, int32 &Length, bool &bEscaped, bool &bAscii) {
+    Start = Pos;
+    bEscaped = false;
+    bAscii = true;
+    while (Pos < End && *Pos != '"') {
+        if (*Pos == '\\') {
+            bEscaped = true;
+            Pos += 2;
+            continue;
+        }
+        if (*Pos >= 0x80) {
+            bAscii = false;
+        }
+        Pos++;
+    }
+    if (Pos >= End) return Fail();
+    Length = Pos - Start;
+    Pos++;
+    return true;
+}
+
+bool FGitlabIntegrationIAPIJsonReader::ReadString(FString &Out) {
+    if (ConsumeNull()) return true;
+    if (!Consume('"')) return Fail();
+
+    const uint8 *Start;
+    int32 Length;
+    bool bEscaped, bAscii;
+    if (!ScanString(Start, Length, bEscaped, bAscii)) return false;
+
+    if (!bEscaped) {
+        if (bAscii) {
+            Out = FString(Length, (const ANSICHAR *) Start);
+        } else {
+            Out.Reset(Length);
+            AppendUtf8(Out, Start, Length);
+        }
+        return true;
+    }
+
+    Out.Reset(Length);
+    const uint8 *StringEnd = Start + Length;
+    const uint8 *Run = Start;
+    const uint8 *It = Start;
+    while (It < StringEnd) {
+        if (*It != '\\') {
+            It++;
+            continue;
+        }
+        AppendUtf8(Out, Run, It - Run);
+        It++;
+        uint8 Escape = *It++;
+        switch (Escape) {
+            case 'b': Out.AppendChar(TEXT('\b')); break;
+            case 'f': Out.AppendChar(TEXT('\f')); break;
+            case 'n': Out.AppendChar(TEXT('\n')); break;
+            case 'r': Out.AppendChar(TEXT('\r')); break;
+            case 't': Out.AppendChar(TEXT('\t')); break;
+            case 'u': {
+                uint32 Codepoint;
+                if (!ParseHex4(It, StringEnd, Codepoint)) return Fail();
+                It += 4;
+                uint32 Low;
+                if (Codepoint >= 0xD800 && Codepoint <= 0xDBFF && StringEnd - It >= 6 && It[0] == '\\' && It[1] == 'u' &&
+                    ParseHex4(It + 2, StringEnd, Low) && Low >= 0xDC00 && Low <= 0xDFFF) {
+                    Codepoint = 0x10000 + ((Codepoint - 0xD800) << 10) + (Low - 0xDC00);
+                    It += 6;
+                }
+                AppendCodepoint(Out, Codepoint);
+                break;
+            }
+            default:
+                // \" \\ \/
+                Out.AppendChar((TCHAR) Escape);
+                break;
+        }
+        Run = It;
+    }
+    AppendUtf8(Out, Run, StringEnd - Run);
+    return true;
+}
+
+bool FGitlabIntegrationIAPIJsonReader::ReadInt(int32 &Out) {
+    if (ConsumeNull()) return true;
+    SkipWhitespace();
+
+    bool bNegative = false;
+    if (Pos < End && *Pos == '-') {
+        bNegative = true;
+        Pos++;
+    }
+    if (Pos >= End || *Pos < '0' || *Pos > '9') return Fail();
+    int64 Value = 0;
+    while (Pos < End && *Pos >= '0' && *Pos <= '9') {
+        Value = Value * 10 + (*Pos - '0');
+        Pos++;
+    }
+    // Fractions and exponents are dropped, the same as assigning a json number to an int property
+    while (Pos < End && (*Pos == '.' || *Pos == 'e' || *Pos == 'E' || *Pos == '+' || *Pos == '-' ||
+                         (*Pos >= '0' && *Pos <= '9'))) {
+        Pos++;
+    }
+    Out = (int32) (bNegative ? -Value : Value);
+    return true;
+}
+
+bool FGitlabIntegrationIAPIJsonReader::ReadBool(bool &Out) {
+    if (ConsumeNull()) return true;
+    if (ConsumeLiteral("true", 4)) {
+        Out = true;
+        return true;
+    }
+    if (ConsumeLiteral("false", 5)) {
+        Out = false;
+        return true;
+    }
+    return Fail();
+}
+
+bool FGitlabIntegrationIAPIJsonReader::ReadDateTime(FDateTime &Out) {
+    if (ConsumeNull()) return true;
+    if (!Consume('"')) return Fail();
+
+    const uint8 *Start;
+    int32 Length;
+    bool bEscaped, bAscii;
+    if (!ScanString(Start, Length, bEscaped, bAscii)) return false;
+
+    const int32 BufferSize = 64;
+    TCHAR Buffer[BufferSize];
+    if (Length >= BufferSize) return true;
+    for (int32 Index = 0; Index < Length; Index++) {
+        Buffer[Index] = (TCHAR) Start[Index];
+    }
+    Buffer[Length] = 0;
+    FDateTime::ParseIso8601(Buffer, Out);
+    return true;
+}
+
+bool FGitlabIntegrationIAPIJsonReader::ReadStringArray(TArray<FString> &Out) {
+    if (ConsumeNull()) return true;
+    if (!BeginArray()) return false;
+    Out.Reset();
+    while (NextElement()) {
+        SkipWhitespace();
+        if (Pos < End && *Pos == '"') {
+            FString &Value = Out[Out.AddDefaulted()];
+            if (!ReadString(Value)) return false;
+        } else if (!SkipValue()) {
+            return false;
+        }
+    }
+    return IsValid();
+}
+
+bool FGitlabIntegrationIAPIJsonReader::SkipValue() {
+    SkipWhitespace();
+    if (Pos >= End) return Fail();
+
+    const uint8 *Start;
+    int32 Length;
+    bool bEscaped, bAscii;
+    switch (*Pos) {
+        case '"':
+            Pos++;
+            return ScanString(Start, Length, bEscaped, bAscii);
+        case '{':
+        case '[': {
+            int32 Depth = 0;
+            while (Pos < End) {
+                uint8 Char = *Pos++;
+                if (Char == '"') {
+                    if (!ScanString(Start, Length, bEscaped, bAscii)) return false;
+                } else if (Char == '{' || Char == '[') {
+                    Depth++;
+                } else if (Char == '}' || Char == ']') {
+                    if (--Depth == 0) return true;
+                }
+            }
+            return Fail();
+        }
+        case 't':
+            return ConsumeLiteral("true", 4) || Fail();
+        case 'f':
+            return ConsumeLiteral("false", 5) || Fail();
+        case 'n':
+            return ConsumeLiteral("null", 4) || Fail();
+        default: {
+            const uint8 *NumberStart = Pos;
+            while (Pos < End && (*Pos == '.' || *Pos == 'e' || *Pos == 'E' || *Pos == '+' || *Pos == '-' ||
+                                 (*Pos >= '0' && *Pos <= '9'))) {
+                Pos++;
+            }
+            return Pos > NumberStart || Fail();
+        }
+    }
+}
+
+#define GITLAB_INTEGRATION_JSON_FIELD(StructType, Member) \
+    { #Member, sizeof(#Member) - 1, &TGitlabIntegrationIAPIJsonMember<StructType, decltype(StructType::Member), &StructType::Member>::Read }
+
+TArrayView<const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPIProject>> TGitlabIntegrationIAPIJsonFields<FGitlabIntegrationIAPIProject>::Get() {
+    static const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPIProject> Fields[] = {
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIProject, id),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIProject, name),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIProject, name_with_namespace),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIProject, path_with_namespace),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIProject, last_activity_at),
+    };
+    return TArrayView<const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPIProject>>(Fields, sizeof(Fields) / sizeof(Fields[0]));
+}
+
+TArrayView<const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPIIssue>> TGitlabIntegrationIAPIJsonFields<FGitlabIntegrationIAPIIssue>::Get() {
+    static const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPIIssue> Fields[] = {
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIIssue, id),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIIssue, iid),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIIssue, project_id),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIIssue, title),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIIssue, state),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIIssue, web_url),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIIssue, labels),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPIIssue, updated_at),
+    };
+    return TArrayView<const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPIIssue>>(Fields, sizeof(Fields) / sizeof(Fields[0]));
+}
+
+TArrayView<const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPILabel>> TGitlabIntegrationIAPIJsonFields<FGitlabIntegrationIAPILabel>::Get() {
+    static const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPILabel> Fields[] = {
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPILabel, id),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPILabel, name),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPILabel, color),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPILabel, text_color),
+        GITLAB_INTEGRATION_JSON_FIELD(FGitlabIntegrationIAPILabel, description),
+    };
+    return TArrayView<const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPILabel>>(Fields, sizeof(Fields) / sizeof(Fields[0]));
+}
+
+#undef GITLAB_INTEGRATION_JSON_FIELD
@@ -0,0 +1,282 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "../../Public/API/IAPIRequestScheduler.h"
+#include "../../Public/API/IAPI.h"
+
+/** A request answered with 429 this often is handed to its caller as failed */
+#define GITLAB_INTEGRATION_MAX_RATE_LIMIT_RETRIES 3
+/** Attempts of a failing GET after the first one, waiting 0.5, 1, 2, 4 s (+-50%) in between */
+#define GITLAB_INTEGRATION_MAX_RETRIES 4
+#define GITLAB_INTEGRATION_RETRY_BASE_DELAY 0.5f
+
+FGitlabIntegrationIAPIRequestScheduler::~FGitlabIntegrationIAPIRequestScheduler() {
+    if (TickHandle.IsValid()) {
+        FTicker::GetCoreTicker().RemoveTicker(TickHandle);
+    }
+}
+
+void FGitlabIntegrationIAPIRequestScheduler::SetLimits(int32 MaxInFlight, float RequestsPerSecond) {
+    MaxInFlightPerHost = FMath::Max(1, MaxInFlight);
+    MaxRate = FMath::Max(0.1f, RequestsPerSecond);
+    // The next response with rate limit headers lowers it again if needed
+    Rate = MaxRate;
+}
+
+void FGitlabIntegrationIAPIRequestScheduler::Enqueue(TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request,
+                                                     EGitlabIntegrationIAPIRequestPriority Priority,
+                                                     const FGitlabIntegrationIAPICancellationTokenPtr &Token) {
+    if (IsCancelled(Token)) return;
+
+    FQueuedRequest Queued;
+    if (Request->GetVerb() == TEXT("GET")) {
+        Queued.Url = Request->GetURL();
+        FPendingGet *Pending = PendingGets.Find(Queued.Url);
+        if (Pending != nullptr && !IsDropped(Pending->Request, Pending->Token, Queued.Url)) {
+            // Same url already on its way, answer this caller with that response
+            Pending->Waiting.Add({Request->OnProcessRequestComplete(), Token});
+            Coalesced++;
+            return;
+        }
+        // A cancelled GET of the url may still be in flight, it ends without an answer and this one is sent anew
+        PendingGets.Add(Queued.Url, {Request, Token, TArray<FWaitingGet>()});
+    }
+    Queued.Request = Request;
+    Queued.Token = Token;
+    Queued.Host = GetHost(Request->GetURL());
+    Queued.EnqueuedAt = FPlatformTime::Seconds();
+    TArray<FQueuedRequest> &Queue = Queues[(int32) Priority];
+    Queue.Add(MoveTemp(Queued));
+    FPriorityStats &PriorityStats = Stats[(int32) Priority];
+    PriorityStats.MaxDepth = FMath::Max(PriorityStats.MaxDepth, Queue.Num());
+    Pump();
+}
+
+void FGitlabIntegrationIAPIRequestScheduler::CancelRequests() {
+    for (TArray<FQueuedRequest> &Queue : Queues) {
+        for (int32 Index = Queue.Num() - 1; Index >= 0; Index--) {
+            if (IsDropped(Queue[Index].Request, Queue[Index].Token, Queue[Index].Url)) {
+                ReleasePendingGet(Queue[Index].Url, Queue[Index].Request);
+                Queue.RemoveAt(Index);
+                Cancelled++;
+            }
+        }
+    }
+
+    // Cancelling may complete the request right away, which changes InFlightRequests
+    TArray<FHttpRequestPtr> ToCancel;
+    for (const FInFlightRequest &InFlight : InFlightRequests) {
+        if (IsDropped(InFlight.Request, InFlight.Token, InFlight.Url)) {
+            // Nothing may attach to it until it has completed, a new GET of the url is sent again
+            ReleasePendingGet(InFlight.Url, InFlight.Request);
+            ToCancel.Add(InFlight.Request);
+        }
+    }
+    for (FHttpRequestPtr &Request : ToCancel) {
+        Request->CancelRequest();
+    }
+}
+
+bool FGitlabIntegrationIAPIRequestScheduler::IsDropped(const FHttpRequestPtr &Request,
+                                                       const FGitlabIntegrationIAPICancellationTokenPtr &Token,
+                                                       const FString &Url) const {
+    if (!IsCancelled(Token)) return false;
+    const FPendingGet *Pending = Url.IsEmpty() ? nullptr : PendingGets.Find(Url);
+    if (Pending != nullptr && Pending->Request == Request) {
+        for (const FWaitingGet &Waiter : Pending->Waiting) {
+            if (!IsCancelled(Waiter.Token)) return false;
+        }
+    }
+    return true;
+}
+
+void FGitlabIntegrationIAPIRequestScheduler::ReleasePendingGet(const FString &Url, const FHttpRequestPtr &Request,
+                                                               TArray<FWaitingGet> *OutWaiting) {
+    FPendingGet *Pending = Url.IsEmpty() ? nullptr : PendingGets.Find(Url);
+    if (Pending == nullptr || Pending->Request != Request) return;
+    if (OutWaiting != nullptr) {
+        *OutWaiting = MoveTemp(Pending->Waiting);
+    }
+    PendingGets.Remove(Url);
+}
+
+int32 FGitlabIntegrationIAPIRequestScheduler::GetQueueDepth() const {
+    int32 Depth = 0;
+    for (const TArray<FQueuedRequest> &Queue : Queues) {
+        Depth += Queue.Num();
+    }
+    return Depth;
+}
+
+void FGitlabIntegrationIAPIRequestScheduler::Pump() {
+    const double Now = FPlatformTime::Seconds();
+    if (LastRefill == 0.0) {
+        LastRefill = Now;
+    }
+    // The bucket holds at most one second worth of requests
+    Tokens = FMath::Min(FMath::Max(Rate, 1.0f), Tokens + (float) (Now - LastRefill) * Rate);
+    LastRefill = Now;
+
+    while (Now >= PausedUntil && Tokens >= 1.0f) {
+        bool bSent = false;
+        for (int32 Priority = 0; Priority < (int32) EGitlabIntegrationIAPIRequestPriority::Num && !bSent; Priority++) {
+            TArray<FQueuedRequest> &Queue = Queues[Priority];
+            for (int32 Index = 0; Index < Queue.Num(); Index++) {
+                if (Queue[Index].NotBefore <= Now && InFlightPerHost.FindRef(Queue[Index].Host) < MaxInFlightPerHost) {
+                    FQueuedRequest Queued = MoveTemp(Queue[Index]);
+                    Queue.RemoveAt(Index);
+                    Send(MoveTemp(Queued), (EGitlabIntegrationIAPIRequestPriority) Priority);
+                    bSent = true;
+                    break;
+                }
+            }
+        }
+        if (!bSent) break;
+        Tokens -= 1.0f;
+    }
+
+    // Waiting for tokens, a backoff or the end of a pause needs a tick, a free slot is reported by HandleComplete
+    if (GetQueueDepth() > 0 && !TickHandle.IsValid()) {
+        TickHandle = FTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FGitlabIntegrationIAPIRequestScheduler::Tick));
+    }
+}
+
+bool FGitlabIntegrationIAPIRequestScheduler::Tick(float DeltaTime) {
+    Pump();
+    if (GetQueueDepth() == 0) {
+        TickHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FGitlabIntegrationIAPIRequestScheduler::Send(FQueuedRequest &&Queued, EGitlabIntegrationIAPIRequestPriority Priority) {
+    const double Wait = FPlatformTime::Seconds() - Queued.EnqueuedAt;
+    FPriorityStats &PriorityStats = Stats[(int32) Priority];
+    PriorityStats.Sent++;
+    PriorityStats.TotalWait += Wait;
+    PriorityStats.MaxWait = FMath::Max(PriorityStats.MaxWait, Wait);
+
+    InFlightPerHost.FindOrAdd(Queued.Host)++;
+    TotalInFlight++;
+
+    // Wrap the caller's delegate so the slot is released and the headers are seen before the caller runs
+    TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request = MoveTemp(Queued.Request);
+    if (!Queued.Completion.IsBound()) {
+        Queued.Completion = Request->OnProcessRequestComplete();
+    }
+    InFlightRequests.Add({Request, Queued.Url, Queued.Token});
+    Request->OnProcessRequestComplete().BindRaw(this, &FGitlabIntegrationIAPIRequestScheduler::HandleComplete,
+                                                Queued, Priority);
+    Request->ProcessRequest();
+}
+
+void FGitlabIntegrationIAPIRequestScheduler::HandleComplete(FHttpRequestPtr Request, FHttpResponsePtr Response,
+                                                            bool bWasSuccessful, FQueuedRequest State,
+                                                            EGitlabIntegrationIAPIRequestPriority Priority) {
+    int32 &HostInFlight = InFlightPerHost.FindOrAdd(State.Host);
+    HostInFlight = FMath::Max(0, HostInFlight - 1);
+    TotalInFlight = FMath::Max(0, TotalInFlight - 1);
+    InFlightRequests.RemoveAll([&Request](const FInFlightRequest &InFlight) { return InFlight.Request == Request; });
+
+    if (Response.IsValid()) {
+        ApplyRateLimitHeaders(Response);
+    }
+
+    // Late response for a project or server which is gone, not even worth retrying
+    if (IsDropped(Request, State.Token, State.Url)) {
+        ReleasePendingGet(State.Url, Request);
+        Cancelled++;
+        Pump();
+        return;
+    }
+
+    if (Response.IsValid()) {
+        if (Response->GetResponseCode() == EHttpResponseCodes::TooManyRequests &&
+            State.RateLimitRetries < GITLAB_INTEGRATION_MAX_RATE_LIMIT_RETRIES) {
+            const int32 RetryAfter = FMath::Max(1, FCString::Atoi(*Response->GetHeader(TEXT("Retry-After"))));
+            PausedUntil = FMath::Max(PausedUntil, FPlatformTime::Seconds() + RetryAfter);
+            Tokens = 0.0f;
+            RateLimited++;
+            UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Rate limited by %s, pausing requests for %d s"), *State.Host, RetryAfter);
+            State.RateLimitRetries++;
+            Requeue(Request, MoveTemp(State), Priority);
+            return;
+        }
+    }
+
+    if (!State.Url.IsEmpty() && State.Retries < GITLAB_INTEGRATION_MAX_RETRIES && ShouldRetry(Response, bWasSuccessful)) {
+        const float Delay = GITLAB_INTEGRATION_RETRY_BASE_DELAY * (1 << State.Retries) * FMath::FRandRange(0.5f, 1.5f);
+        State.Retries++;
+        State.NotBefore = FPlatformTime::Seconds() + Delay;
+        Retried++;
+        UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Request to %s failed (%d), retry %d in %.1f s"), *State.Url,
+               Response.IsValid() ? Response->GetResponseCode() : 0, State.Retries, Delay);
+        Requeue(Request, MoveTemp(State), Priority);
+        return;
+    }
+
+    // Callers which attached to this GET get the same response, a new GET of the url from any of them is sent again
+    TArray<FWaitingGet> Waiting;
+    ReleasePendingGet(State.Url, Request, &Waiting);
+    if (!IsCancelled(State.Token)) {
+        State.Completion.ExecuteIfBound(Request, Response, bWasSuccessful);
+    }
+    for (FWaitingGet &Waiter : Waiting) {
+        if (!IsCancelled(Waiter.Token)) {
+            Waiter.Completion.ExecuteIfBound(Request, Response, bWasSuccessful);
+        }
+    }
+    Pump();
+}
+
+void FGitlabIntegrationIAPIRequestScheduler::Requeue(FHttpRequestPtr Request, FQueuedRequest &&State,
+                                                     EGitlabIntegrationIAPIRequestPriority Priority) {
+    // Ahead of everything else of its priority, it was first in line already
+    State.Request = Request;
+    State.EnqueuedAt = FPlatformTime::Seconds();
+    Queues[(int32) Priority].Insert(MoveTemp(State), 0);
+    Pump();
+}
+
+bool FGitlabIntegrationIAPIRequestScheduler::ShouldRetry(FHttpResponsePtr Response, bool bWasSuccessful) {
+    if (!bWasSuccessful || !Response.IsValid()) return true;
+    const int32 Code = Response->GetResponseCode();
+    return Code >= 500 || Code == EHttpResponseCodes::RequestTimeout;
+}
+
+void FGitlabIntegrationIAPIRequestScheduler::ApplyRateLimitHeaders(FHttpResponsePtr Response) {
+    const FString Remaining = Response->GetHeader(TEXT("RateLimit-Remaining"));
+    const FString Reset = Response->GetHeader(TEXT("RateLimit-Reset"));
+    if (Remaining.IsEmpty() || Reset.IsEmpty()) return;
+
+    // Spread what is left of the window evenly over the time until it resets
+    const int64 SecondsLeft = FMath::Max<int64>(1, FCString::Atoi64(*Reset) - FDateTime::UtcNow().ToUnixTimestamp());
+    const int32 Left = FCString::Atoi(*Remaining);
+    if (Left <= 0) {
+        PausedUntil = FMath::Max(PausedUntil, FPlatformTime::Seconds() + SecondsLeft);
+        UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Rate limit exhausted, pausing requests for %lld s"), SecondsLeft);
+        return;
+    }
+    Rate = FMath::Clamp((float) Left / SecondsLeft, 0.1f, MaxRate);
+}
+
+FString FGitlabIntegrationIAPIRequestScheduler::GetHost(const FString &Url) {
+    int32 Start = Url.Find(TEXT("://"));
+    Start = Start == INDEX_NONE ? 0 : Start + 3;
+    int32 End = Url.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Start);
+    return End == INDEX_NONE ? Url.Mid(Start) : Url.Mid(Start, End - Start);
+}
+
+void FGitlabIntegrationIAPIRequestScheduler::LogStats() const {
+    static const TCHAR *Names[] = {TEXT("interactive"), TEXT("foreground"), TEXT("background")};
+    for (int32 Priority = 0; Priority < (int32) EGitlabIntegrationIAPIRequestPriority::Num; Priority++) {
+        const FPriorityStats &PriorityStats = Stats[Priority];
+        if (PriorityStats.Sent == 0) continue;
+        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Requests %s: %d sent, %d queued (max %d), wait avg %.3f s max %.3f s"),
+               Names[Priority], PriorityStats.Sent, Queues[Priority].Num(), PriorityStats.MaxDepth,
+               PriorityStats.TotalWait / PriorityStats.Sent, PriorityStats.MaxWait);
+    }
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Request rate %.1f/s, %d in flight, rate limited %d times, %d retries, %d duplicate GETs coalesced, %d cancelled"),
+           Rate, TotalInFlight, RateLimited, Retried, Coalesced, Cancelled);
+}
@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "../../Public/API/IAPISearchIndex.h"
+
+void FGitlabIntegrationIAPISearchIndex::GetTrigrams(const FString &Text, TArray<uint64> &OutTrigrams) {
+    OutTrigrams.Reset();
+    const int32 Length = Text.Len();
+    for (int32 Index = 0; Index + 2 < Length; Index++) {
+        // 21 bits per character is enough for any unicode codepoint
+        uint64 Trigram = ((uint64) (FChar::ToLower(Text[Index]) & 0x1FFFFF) << 42) |
+                         ((uint64) (FChar::ToLower(Text[Index + 1]) & 0x1FFFFF) << 21) |
+                         (uint64) (FChar::ToLower(Text[Index + 2]) & 0x1FFFFF);
+        OutTrigrams.AddUnique(Trigram);
+    }
+}
+
+void FGitlabIntegrationIAPISearchIndex::ParseNumbers(const FString &Search, TArray<int32> &OutNumbers) {
+    OutNumbers.Reset();
+    const int32 Length = Search.Len();
+    for (int32 Index = 0; Index < Length; Index++) {
+        if (Search[Index] != TEXT('#')) continue;
+        int32 Number = 0;
+        int32 Digits = 0;
+        while (Index + 1 < Length && FChar::IsDigit(Search[Index + 1]) && Digits < 9) {
+            Number = Number * 10 + (Search[++Index] - TEXT('0'));
+            Digits++;
+        }
+        if (Digits > 0) {
+            OutNumbers.AddUnique(Number);
+        }
+    }
+}
+
+void FGitlabIntegrationIAPISearchIndex::Add(int32 IssueId, int32 Number, const FString &Title) {
+    Remove(IssueId);
+
+    TArray<uint64> &Trigrams = IssueTrigrams.Add(IssueId);
+    GetTrigrams(Title, Trigrams);
+    for (uint64 Trigram : Trigrams) {
+        Postings.FindOrAdd(Trigram).Add(IssueId);
+    }
+    IssueNumbers.Add(IssueId, Number);
+    NumberToIssues.FindOrAdd(Number).Add(IssueId);
+}
+
+void FGitlabIntegrationIAPISearchIndex::Remove(int32 IssueId) {
+    TArray<uint64> Trigrams;
+    if (IssueTrigrams.RemoveAndCopyValue(IssueId, Trigrams)) {
+        for (uint64 Trigram : Trigrams) {
+            TSet<int32> *Posting = Postings.Find(Trigram);
+            if (Posting != nullptr) {
+                Posting->Remove(IssueId);
+                if (Posting->Num() == 0) {
+                    Postings.Remove(Trigram);
+                }
+            }
+        }
+    }
+    int32 Number;
+    if (IssueNumbers.RemoveAndCopyValue(IssueId, Number)) {
+        if (TArray<int32> *Issues = NumberToIssues.Find(Number)) {
+            Issues->RemoveSingleSwap(IssueId);
+            if (Issues->Num() == 0) {
+                NumberToIssues.Remove(Number);
+            }
+        }
+    }
+}
+
+void FGitlabIntegrationIAPISearchIndex::Empty() {
+    Postings.Empty();
+    IssueTrigrams.Empty();
+    NumberToIssues.Empty();
+    IssueNumbers.Empty();
+}
+
+bool FGitlabIntegrationIAPISearchIndex::Query(const FString &Search, TSet<int32> &OutIssueIds) const {
+    OutIssueIds.Reset();
+
+    TArray<uint64> Trigrams;
+    GetTrigrams(Search, Trigrams);
+    if (Trigrams.Num() == 0) {
+        return false;
+    }
+
+    // Walk the shortest posting list and keep what is in all the others
+    const TSet<int32> *Shortest = nullptr;
+    TArray<const TSet<int32> *, TInlineAllocator<16>> Others;
+    for (uint64 Trigram : Trigrams) {
+        const TSet<int32> *Posting = Postings.Find(Trigram);
+        if (Posting == nullptr) {
+            Shortest = nullptr;
+            Others.Reset();
+            break;
+        }
+        if (Shortest == nullptr || Posting->Num() < Shortest->Num()) {
+            if (Shortest != nullptr) {
+                Others.Add(Shortest);
+            }
+            Shortest = Posting;
+        } else {
+            Others.Add(Posting);
+        }
+    }
+    if (Shortest != nullptr) {
+        for (int32 IssueId : *Shortest) {
+            bool InAll = true;
+            for (const TSet<int32> *Posting : Others) {
+                if (!Posting->Contains(IssueId)) {
+                    InAll = false;
+                    break;
+                }
+            }
+            if (InAll) {
+                OutIssueIds.Add(IssueId);
+            }
+        }
+    }
+
+    TArray<int32> Numbers;
+    ParseNumbers(Search, Numbers);
+    for (int32 Number : Numbers) {
+        if (const TArray<int32> *Issues = NumberToIssues.Find(Number)) {
+            OutIssueIds.Append(*Issues);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "../../Public/API/IAPIWebhookReceiver.h"
+#include "HttpServerModule.h"
+#include "HttpServerResponse.h"
+#include "HttpPath.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FGitlabIntegrationIAPIWebhookReceiver::~FGitlabIntegrationIAPIWebhookReceiver() {
+    Stop();
+}
+
+bool FGitlabIntegrationIAPIWebhookReceiver::Start(IAPI *InApi, uint32 Port, const FString &Path, const FString &InSecret) {
+    Stop();
+    if (InSecret.IsEmpty()) {
+        UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Webhook receiver needs a secret token, not starting it"));
+        return false;
+    }
+    Api = InApi;
+    Secret = InSecret;
+
+    Router = FHttpServerModule::Get().GetHttpRouter(Port);
+    if (!Router.IsValid()) {
+        UE_LOG(LogGitlabIntegrationIAPI, Error, TEXT("Cannot listen for webhooks on port %u"), Port);
+        return false;
+    }
+    RouteHandle = Router->BindRoute(FHttpPath(Path), EHttpServerRequestVerbs::VERB_POST,
+        [this](const FHttpServerRequest &Request, const FHttpResultCallback &OnComplete) {
+            return HandleRequest(Request, OnComplete);
+        });
+    if (!RouteHandle.IsValid()) {
+        UE_LOG(LogGitlabIntegrationIAPI, Error, TEXT("Webhook route %s on port %u is already taken"), *Path, Port);
+        Router.Reset();
+        return false;
+    }
+    FHttpServerModule::Get().StartAllListeners();
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Listening for webhooks on port %u at %s"), Port, *Path);
+    return true;
+}
+
+void FGitlabIntegrationIAPIWebhookReceiver::Stop() {
+    if (Router.IsValid() && RouteHandle.IsValid()) {
+        Router->UnbindRoute(RouteHandle);
+        UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Webhook receiver stopped, %d events applied, %d refused"),
+               EventsApplied, EventsRefused);
+    }
+    RouteHandle.Reset();
+    Router.Reset();
+}
+
+bool FGitlabIntegrationIAPIWebhookReceiver::HandleRequest(const FHttpServerRequest &Request, const FHttpResultCallback &OnComplete) {
+    if (!SecretMatches(GetHeader(Request, TEXT("X-Gitlab-Token")), Secret)) {
+        EventsRefused++;
+        UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Refusing webhook without the secret token"));
+        OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::Denied));
+        return true;
+    }
+
+    // Anything else is acknowledged, Gitlab disables hooks which keep failing
+    const FString Event = GetHeader(Request, TEXT("X-Gitlab-Event"));
+    if (Event != TEXT("Issue Hook") && Event != TEXT("Confidential Issue Hook")) {
+        UE_LOG(LogGitlabIntegrationIAPI, Verbose, TEXT("Ignoring webhook event %s"), *Event);
+        OnComplete(FHttpServerResponse::Ok());
+        return true;
+    }
+
+    FUTF8ToTCHAR Converted((const ANSICHAR *) Request.Body.GetData(), Request.Body.Num());
+    TSharedPtr<FJsonObject> Root;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get()));
+    FGitlabIntegrationIAPIIssue Issue;
+    TArray<FGitlabIntegrationIAPILabel> EventLabels;
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !ParseIssueEvent(Root, Issue, EventLabels)) {
+        UE_LOG(LogGitlabIntegrationIAPI, Warning, TEXT("Malformed issue webhook"));
+        OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest));
+        return true;
+    }
+
+    UE_LOG(LogGitlabIntegrationIAPI, Log, TEXT("Webhook: issue #%d is %s"), Issue.iid, *Issue.state);
+    Api->ApplyIssueEvent(MoveTemp(Issue), MoveTemp(EventLabels));
+    EventsApplied++;
+    OnComplete(FHttpServerResponse::Ok());
+    return true;
+}
+
+FString FGitlabIntegrationIAPIWebhookReceiver::GetHeader(const FHttpServerRequest &Request, const FString &Name) {
+    // FString keys compare case insensitively, as header names should
+    const TArray<FString> *Values = Request.Headers.Find(Name);
+    return Values != nullptr && Values->Num() > 0 ? (*Values)[0] : FString();
+}
+
+bool FGitlabIntegrationIAPIWebhookReceiver::SecretMatches(const FString &Token, const FString &Expected) {
+    if (Token.Len() != Expected.Len()) return false;
+    uint32 Difference = 0;
+    for (int32 Index = 0; Index < Token.Len(); Index++) {
+        Difference |= (uint32) (Token[Index] ^ Expected[Index]);
+    }
+    return Difference == 0;
+}
+
+bool FGitlabIntegrationIAPIWebhookReceiver::ParseIssueEvent(const TSharedPtr<FJsonObject> &Event,
+                                                            FGitlabIntegrationIAPIIssue &OutIssue,
+                                                            TArray<FGitlabIntegrationIAPILabel> &OutLabels) {
+    const TSharedPtr<FJsonObject> *Attributes = nullptr;
+    if (!Event->TryGetObjectField(TEXT("object_attributes"), Attributes)) return false;
+    const FJsonObject &Issue = **Attributes;
+    if (!Issue.TryGetNumberField(TEXT("id"), OutIssue.id) || !Issue.TryGetNumberField(TEXT("iid"), OutIssue.iid) ||
+        !Issue.TryGetNumberField(TEXT("project_id"), OutIssue.project_id)) {
+        return false;
+    }
+    Issue.TryGetStringField(TEXT("title"), OutIssue.title);
+    Issue.TryGetStringField(TEXT("state"), OutIssue.state);
+    Issue.TryGetStringField(TEXT("url"), OutIssue.web_url);
+    // updated_at feeds the sync watermark and decides which copy is newer, a made up time would be worse than none
+    FString UpdatedAt;
+    if (!Issue.TryGetStringField(TEXT("updated_at"), UpdatedAt) || !ParseTimestamp(UpdatedAt, OutIssue.updated_at)) {
+        return false;
+    }
+
+    // The labels of the issue with their colors, object_attributes only has their ids
+    const TArray<TSharedPtr<FJsonValue>> *Labels = nullptr;
+    if (Event->TryGetArrayField(TEXT("labels"), Labels)) {
+        for (const TSharedPtr<FJsonValue> &Value : *Labels) {
+            const TSharedPtr<FJsonObject> *LabelObject = nullptr;
+            if (!Value->TryGetObject(LabelObject)) continue;
+            FGitlabIntegrationIAPILabel Label;
+            if (!(*LabelObject)->TryGetNumberField(TEXT("id"), Label.id) ||
+                !(*LabelObject)->TryGetStringField(TEXT("title"), Label.name)) {
+                continue;
+            }
+            (*LabelObject)->TryGetStringField(TEXT("color"), Label.color);
+            (*LabelObject)->TryGetStringField(TEXT("description"), Label.description);
+            (*LabelObject)->TryGetStringField(TEXT("text_color"), Label.text_color);
+            OutIssue.labels.Add(Label.name);
+            OutLabels.Add(MoveTemp(Label));
+        }
+    }
+    return true;
+}
+
+bool FGitlabIntegrationIAPIWebhookReceiver::ParseTimestamp(const FString &Value, FDateTime &Out) {
+    FString Iso = Value;
+    if (Iso.EndsWith(TEXT(" UTC"))) {
+        Iso = Iso.LeftChop(4) + TEXT("Z");
+        Iso.ReplaceInline(TEXT(" "), TEXT("T"));
+    }
+    return FDateTime::ParseIso8601(*Iso, Out);
+}
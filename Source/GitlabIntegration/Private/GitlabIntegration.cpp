@@ -7,6 +7,8 @@
 #include "GitlabIntegrationCommands.h"
 #include "LevelEditor.h"
 #include "Math/Color.h"
+#include "HAL/PlatformApplicationMisc.h"
+#include "Algo/BinarySearch.h"
 #include "EditorStyleSet.h"
 #include "Styling/ISlateStyle.h"
 #include "Widgets/Docking/SDockTab.h"
@@ -26,6 +28,7 @@
 #include "ISettingsContainer.h"
 #include "Settings/GitlabIntegrationSettings.h"
 #include "../Public/API/GitlabAPI.h"
+#include "../Public/API/GitlabGraphQLAPI.h"
 
 static const FName GitlabIntegrationTabName("Gitlab");
 
@@ -43,10 +46,36 @@ void FGitlabIntegrationModule::StartupModule() {
                GITLAB_INTEGRATION_DEFAULT_SERVER);
     }
     IssueSortNewFirst = Settings->SortIssuesNewestFirst;
+    IssueRefreshDebounce = Settings->IssueRefreshDebounceSeconds;
+    TickHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGitlabIntegrationModule::Tick));
 
-    Api = new GitlabAPI(Settings->Server, Settings->Token, Settings->Project,
-                        std::bind(&FGitlabIntegrationModule::RefreshIssues, this),
-                        std::bind(&FGitlabIntegrationModule::RefreshLabels, this));
+    FGitlabIntegrationIAPIIssueCallback IssueCallback = std::bind(&FGitlabIntegrationModule::HandleIssueDelta, this, std::placeholders::_1);
+    FGitlabIntegrationIAPILabelCallback LabelCallback = std::bind(&FGitlabIntegrationModule::HandleLabelDelta, this, std::placeholders::_1);
+    if (Settings->UseGraphQLApi) {
+        Api = new GitlabGraphQLAPI(Settings->Server, Settings->Token, Settings->Project, IssueCallback, LabelCallback);
+    } else {
+        Api = new GitlabAPI(Settings->Server, Settings->Token, Settings->Project, IssueCallback, LabelCallback);
+    }
+    Api->SetMaxConcurrentPages(Settings->MaxConcurrentPageRequests);
+    Api->SetRequestLimits(Settings->MaxRequestsInFlight, Settings->MaxRequestsPerSecond);
+    Api->SetIncrementalSync(Settings->IncrementalIssueSync);
+    Api->SetVerifyJsonDecoder(Settings->VerifyJsonDecoder);
+    Api->SetLoadProjectLocation(Settings->ProjectId, Settings->ProjectPath);
+    Api->SetProjectCallback(std::bind(&FGitlabIntegrationModule::RefreshProjects, this));
+    Api->SetLoadGroup(Settings->Group);
+    Api->SetCacheFile(FPaths::ProjectSavedDir() / TEXT("GitlabIntegration") / TEXT("Cache.bin"));
+    // Before LoadCache, which publishes the cached issues to the view right away
+    ProjectFilter = Api->IsGroupMode() ? Settings->ProjectId : -1;
+    if (!Api->LoadCache()) {
+        if (Api->IsGroupMode()) {
+            Api->FetchProjectContent();
+        } else {
+            Api->ResolveProject();
+        }
+    }
+    UpdateWebhookReceiver();
+    PollInterval = Settings->MinPollIntervalSeconds;
+    SchedulePoll();
 
     if (ProjectSelectionButtonText.IsValid()) {
         if (!Settings->Project.IsEmpty()) {
@@ -110,6 +139,13 @@ void FGitlabIntegrationModule::ShutdownModule() {
     FGitlabIntegrationCommands::Unregister();
     UnregisterSettings();
 
+    FTicker::GetCoreTicker().RemoveTicker(TickHandle);
+    UE_LOG(LogGitlabIntegration, Log, TEXT("Issue view rebuilt %d times for %d refresh requests"),
+           IssueRefreshesRun, IssueRefreshRequests);
+
+    WebhookReceiver.Stop();
+    FTicker::GetCoreTicker().RemoveTicker(PollHandle);
+    Api->SaveCache();
     delete Api;
     FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(GitlabIntegrationTabName);
 }
@@ -120,7 +156,9 @@ TSharedRef<SDockTab> FGitlabIntegrationModule::OnSpawnPluginTab(const FSpawnTabA
         StartupModule();
     }
     if (Settings != nullptr) {
-        return SNew(SDockTab)
+        // Rows belong to the list view of the previous tab
+        IssueRows.Empty();
+        TSharedRef<SDockTab> Tab = SNew(SDockTab)
                    .TabRole(ETabRole::NomadTab)
                    [
                            SNew(SScrollBox)
@@ -219,7 +257,7 @@ TSharedRef<SDockTab> FGitlabIntegrationModule::OnSpawnPluginTab(const FSpawnTabA
                                                                                        ECheckBoxState::Checked;
                                                                                    IssueSortNewFirst = (CheckBoxState ==
                                                                                                         ECheckBoxState::Checked);
-                                                                                   RefreshIssues();
+                                                                                   RequestIssueRefresh();
                                                                                })
 
                                                                ]
@@ -264,9 +302,49 @@ TSharedRef<SDockTab> FGitlabIntegrationModule::OnSpawnPluginTab(const FSpawnTabA
                                                                                   TEXT("Searching for %s"),
                                                                                   *NewText.ToString());
                                                                            IssueSearch = NewText.ToString();
-                                                                           RefreshIssues();
+                                                                           RequestIssueRefresh();
                                                                        })]
                                                                +
+                                                               SHorizontalBox::Slot()
+                                                                   .Padding(
+                                                                       0.0f,
+                                                                       3.0f,
+                                                                       6.0f,
+                                                                       3.0f)
+                                                                   .AutoWidth()
+                                                                   .VAlign(VAlign_Center)
+                                                               [
+                                                                       SNew(STextBlock)
+                                                                           .Text_Lambda([this]() { return GetIssueViewSummary(); })
+                                                               ]
+                                                               +
+                                                               SHorizontalBox::Slot()
+                                                                   .Padding(
+                                                                       0.0f,
+                                                                       3.0f,
+                                                                       6.0f,
+                                                                       3.0f)
+                                                                   .AutoWidth()
+                                                                   .VAlign(VAlign_Center)
+                                                               [
+                                                                       SNew(SCheckBox)
+                                                                           .ToolTipText(LOCTEXT("GILabelMatchAllTooltip",
+                                                                                                "Show only issues with all of the selected labels instead of any of them"))
+                                                                           .IsChecked_Lambda([this]() {
+                                                                               return LabelFilterMatchAll ? ECheckBoxState::Checked
+                                                                                                          : ECheckBoxState::Unchecked;
+                                                                           })
+                                                                           .OnCheckStateChanged_Lambda(
+                                                                               [this](ECheckBoxState CheckBoxState) {
+                                                                                   LabelFilterMatchAll = CheckBoxState == ECheckBoxState::Checked;
+                                                                                   RequestIssueRefresh();
+                                                                               })
+                                                                       [
+                                                                           SNew(STextBlock)
+                                                                           .Text(LOCTEXT("GILabelMatchAll", "All labels"))
+                                                                       ]
+                                                               ]
+                                                               +
                                                                SHorizontalBox::Slot()
                                                                    .Padding(
                                                                        0.0f,
@@ -289,7 +367,7 @@ TSharedRef<SDockTab> FGitlabIntegrationModule::OnSpawnPluginTab(const FSpawnTabA
                                                                                 .VAlign(VAlign_Fill)
                                                                                 .OnClicked_Lambda(
                                                                                     [this]() -> FReply {
-                                                                                        Api->RefreshIssues();
+                                                                                        Api->RefreshIssues(EGitlabIntegrationIAPIRequestPriority::Interactive);
                                                                                         return FReply::Handled();
                                                                                     })
                                                                             [SNew(SBorder)
@@ -305,9 +383,46 @@ TSharedRef<SDockTab> FGitlabIntegrationModule::OnSpawnPluginTab(const FSpawnTabA
                                                                ]
                                                        ]
                                                        + SVerticalBox::Slot()
-                                                           .VAlign(VAlign_Center)
+                                                           .AutoHeight()
                                                        [
-                                                               SAssignNew(LabelWrapBox, SWrapBox).UseAllottedWidth(true)
+                                                               SNew(SExpandableArea)
+                                                                   .AreaTitle(LOCTEXT("GitlabIntegrationLabels", "Labels"))
+                                                                   .InitiallyCollapsed(false)
+                                                                   .Padding(4.0f)
+                                                                   .BodyContent()
+                                                               [
+                                                                       SNew(SVerticalBox)
+                                                                       + SVerticalBox::Slot()
+                                                                           .AutoHeight()
+                                                                           .Padding(0.0f, 3.0f, 6.0f, 3.0f)
+                                                                       [
+                                                                               SNew(SSearchBox)
+                                                                                   .HintText(LOCTEXT("GILabelSearchBoxHint", "Search labels"))
+                                                                                   .OnTextChanged_Lambda([this](const FText &NewText) {
+                                                                                       LabelSearch = NewText.ToString();
+                                                                                       RequestLabelRefresh();
+                                                                                   })
+                                                                       ]
+                                                                       + SVerticalBox::Slot()
+                                                                           .AutoHeight()
+                                                                       [
+                                                                               // Only the visible tiles get widgets, the bar stays cheap with thousands of labels
+                                                                               SNew(SBox)
+                                                                                   .MaxDesiredHeight(160.0f)
+                                                                               [
+                                                                                       SAssignNew(LabelTileView, STileView<TSharedPtr<FGitlabIntegrationIAPILabel>>)
+                                                                                           .ListItemsSource(&LabelList)
+                                                                                           .SelectionMode(ESelectionMode::None)
+                                                                                           .ItemWidth(180.0f)
+                                                                                           .ItemHeight(28.0f)
+                                                                                           .OnGenerateTile_Lambda(
+                                                                                               [this](TSharedPtr<FGitlabIntegrationIAPILabel> LabelInfo,
+                                                                                                      const TSharedRef<STableViewBase> &OwnerTable) {
+                                                                                                   return GenerateLabelTile(LabelInfo, OwnerTable);
+                                                                                               })
+                                                                               ]
+                                                                       ]
+                                                               ]
                                                        ]
                                                        + SVerticalBox::Slot()
                                                            .AutoHeight()
@@ -323,7 +438,6 @@ TSharedRef<SDockTab> FGitlabIntegrationModule::OnSpawnPluginTab(const FSpawnTabA
                                                                        [this](
                                                                            TSharedPtr<FGitlabIntegrationIAPIIssue> IssueInfo,
                                                                            const TSharedRef<STableViewBase> &OwnerTable) -> TSharedRef<ITableRow> {
-                                                                           RefreshLabels(); //FIXME: Dirty hack to load labels on start should be in the above slot
                                                                            return GenerateIssueWidget(
                                                                                IssueInfo,
                                                                                OwnerTable);
@@ -335,6 +449,9 @@ TSharedRef<SDockTab> FGitlabIntegrationModule::OnSpawnPluginTab(const FSpawnTabA
                                        ]
                                ]
                    ];
+        // Labels may have arrived before the wrap box existed
+        RequestLabelRefresh();
+        return Tab;
     } else {
         return SNew(SDockTab)
                    .TabRole(ETabRole::NomadTab)
@@ -346,30 +463,27 @@ TSharedRef<SDockTab> FGitlabIntegrationModule::OnSpawnPluginTab(const FSpawnTabA
 
 TSharedRef<ITableRow> FGitlabIntegrationModule::GenerateIssueWidget(TSharedPtr<FGitlabIntegrationIAPIIssue> IssueInfo,
                                                                     const TSharedRef<STableViewBase> &OwnerTable) {
-    FString separator = TEXT(", ");
-
-    TSharedRef<SWrapBox> IssueLabels = SNew(SWrapBox).UseAllottedWidth(true);
-    for (auto &label: IssueInfo->labels) {
-        UE_LOG(LogGitlabIntegration, Log, TEXT("Processing label %s"), *label);
-        auto l = Api->GetLabel(label);
-        UE_LOG(LogGitlabIntegration, Log, TEXT("Processing label %s"), *l->name);
-        IssueLabels->AddSlot()[
-            GenerateLabelWidget(l, true)
-        ];
+    if (FGitlabIntegrationIssueRow *Cached = IssueRows.Find(IssueInfo->id)) {
+        Cached->LastUsed = ++IssueRowUseCounter;
+        return Cached->Row.ToSharedRef();
     }
+
+    FGitlabIntegrationIssueRow Row;
+    Row.Labels = SNew(SWrapBox).UseAllottedWidth(true);
+    FillIssueRowLabels(Row, *IssueInfo);
+
+    // All brushes in Source/Editor/EditorStyle/Private/SlateEditorStyle.cpp
+    const FSlateBrush *StopBrush = FEditorStyle::GetBrush("PlayWorld.StopPlaySession");
+    const FSlateBrush *PlayBrush = FEditorStyle::GetBrush("PlayWorld.PlayInViewport");
     TSharedPtr<SBorder> TimeBorder = SNew(SBorder)
-                                         // All brushes in Source/Editor/EditorStyle/Private/SlateEditorStyle.cpp
-                                             .BorderImage(
-                                                 FEditorStyle::GetBrush(
-                                                     TimeTrackingMap.Contains(IssueInfo)
-                                                     ? "PlayWorld.StopPlaySession"
-                                                     : "PlayWorld.PlayInViewport"))
+                                             .BorderImage_Lambda([this, IssueInfo, StopBrush, PlayBrush]() {
+                                                 return TimeTrackingMap.Contains(IssueInfo) ? StopBrush : PlayBrush;
+                                             })
                                              .Padding(
                                                  FMargin(1.0f))
                                              .HAlign(HAlign_Fill)
                                              .VAlign(VAlign_Fill);
-//    TimeTrackingBorderMap
-    return SNew(STableRow<TSharedPtr<FGitlabIntegrationIAPIIssue >>, OwnerTable)
+    Row.Row = SNew(STableRow<TSharedPtr<FGitlabIntegrationIAPIIssue >>, OwnerTable)
                [
                        SNew(SVerticalBox)
                        + SVerticalBox::Slot()
@@ -384,9 +498,7 @@ TSharedRef<ITableRow> FGitlabIntegrationModule::GenerateIssueWidget(TSharedPtr<F
                                        .RowSpan(1)
                                    [
                                            SNew(SHyperlink)
-                                               .Text(FText::FromString(TEXT("#") +
-                                                                       FString::FromInt(
-                                                                           IssueInfo->iid)))
+                                               .Text(GetIssueReference(*IssueInfo))
                                                .OnNavigate_Lambda([IssueInfo]() {
                                                    FPlatformProcess::LaunchURL(
                                                        *IssueInfo->web_url,
@@ -398,25 +510,14 @@ TSharedRef<ITableRow> FGitlabIntegrationModule::GenerateIssueWidget(TSharedPtr<F
                                        .ColumnSpan(1)
                                        .RowSpan(1)
                                    [
-                                           SNew(STextBlock)
-                                           .Text(FText::FromString(IssueInfo->title))
+                                           SAssignNew(Row.Title, STextBlock)
                                    ]
                                    + SGridPanel::Slot(0, 1)
                                        .Padding(0.0f, 4.0f, 4.0f, 4.0f)
                                        .ColumnSpan(1)
                                        .RowSpan(1)
                                    [
-                                           SNew(STextBlock)
-                                               .Text(FText::FromString(
-                                                   IssueInfo->state))
-                                               .ColorAndOpacity(
-                                                   IssueInfo->state.Equals(
-                                                       TEXT("opened"),
-                                                       ESearchCase::IgnoreCase)
-                                                   ? FLinearColor(
-                                                       FColor(0xff57a64a))
-                                                   : FLinearColor(
-                                                       FColor(0xffcfcfcf)))
+                                           SAssignNew(Row.State, STextBlock)
                                    ]
                                    + SGridPanel::Slot(1, 1)
                                        .Padding(0.0f, 4.0f, 4.0f,
@@ -425,7 +526,7 @@ TSharedRef<ITableRow> FGitlabIntegrationModule::GenerateIssueWidget(TSharedPtr<F
                                        .RowSpan(
                                            1)
                                    [
-                                       IssueLabels
+                                       Row.Labels.ToSharedRef()
                                    ]
                                    + SGridPanel::Slot(2, 0)
                                        .Padding(
@@ -451,7 +552,8 @@ TSharedRef<ITableRow> FGitlabIntegrationModule::GenerateIssueWidget(TSharedPtr<F
                                                        .HAlign(HAlign_Fill)
                                                        .VAlign(VAlign_Fill)
                                                        .OnClicked_Lambda(
-                                                           [this, IssueInfo, OwnerTable]() -> FReply {
+                                                           [this, IssueInfo]() -> FReply {
+                                                               // The brush follows TimeTrackingMap, no row has to be rebuilt
                                                                if (TimeTrackingMap.Contains(
                                                                    IssueInfo)) {
                                                                    FinishTimeTracking(
@@ -468,7 +570,6 @@ TSharedRef<ITableRow> FGitlabIntegrationModule::GenerateIssueWidget(TSharedPtr<F
                                                                        IssueInfo,
                                                                        FDateTime::UtcNow());
                                                                }
-                                                               OwnerTable->RebuildList();
                                                                return FReply::Handled();
                                                            })
                                                    [TimeBorder.ToSharedRef()]
@@ -482,11 +583,68 @@ TSharedRef<ITableRow> FGitlabIntegrationModule::GenerateIssueWidget(TSharedPtr<F
                                 .Padding(FMargin(1.0f))
                                 .HAlign(HAlign_Fill)]
                ];
+    UpdateIssueRow(Row, *IssueInfo);
+    Row.LastUsed = ++IssueRowUseCounter;
+
+    TSharedRef<ITableRow> Result = Row.Row.ToSharedRef();
+    // While a rebuild is pending the list may still show issues that left the store, nothing would evict their rows
+    if (Api->Issues.FindRef(IssueInfo->id) == IssueInfo) {
+        IssueRows.Add(IssueInfo->id, MoveTemp(Row));
+        TrimIssueRows();
+    }
+    return Result;
+}
+
+void FGitlabIntegrationModule::UpdateIssueRow(FGitlabIntegrationIssueRow &Row, const FGitlabIntegrationIAPIIssue &Issue) {
+    Row.Title->SetText(FText::FromString(Issue.title));
+    Row.State->SetText(FText::FromString(Issue.state));
+    Row.State->SetColorAndOpacity(Issue.state.Equals(TEXT("opened"), ESearchCase::IgnoreCase)
+                                  ? FLinearColor(FColor(0xff57a64a))
+                                  : FLinearColor(FColor(0xffcfcfcf)));
+    if (Row.LabelIds != Issue.LabelIds) {
+        FillIssueRowLabels(Row, Issue);
+    }
+}
+
+void FGitlabIntegrationModule::FillIssueRowLabels(FGitlabIntegrationIssueRow &Row, const FGitlabIntegrationIAPIIssue &Issue) {
+    Row.Labels->ClearChildren();
+    for (auto &label: Issue.labels) {
+        Row.Labels->AddSlot()[
+            GenerateLabelWidget(Api->GetLabel(label), true)
+        ];
+    }
+    Row.LabelIds = Issue.LabelIds;
+}
+
+void FGitlabIntegrationModule::TrimIssueRows() {
+    if (IssueRows.Num() <= IssueRowCacheSize) return;
+
+    // Rows still referenced by the list view are on screen and stay
+    TArray<TPair<uint64, int32>> Unused;
+    for (auto &Row : IssueRows) {
+        if (Row.Value.Row.IsUnique()) {
+            Unused.Emplace(Row.Value.LastUsed, Row.Key);
+        }
+    }
+    Unused.Sort([](const TPair<uint64, int32> &A, const TPair<uint64, int32> &B) { return A.Key < B.Key; });
+    // Trim to three quarters so that the next rows can be added without trimming again
+    const int32 Excess = IssueRows.Num() - IssueRowCacheSize * 3 / 4;
+    for (int32 Index = 0; Index < Excess && Index < Unused.Num(); Index++) {
+        IssueRows.Remove(Unused[Index].Value);
+    }
+}
+
+TSharedRef<ITableRow> FGitlabIntegrationModule::GenerateLabelTile(TSharedPtr<FGitlabIntegrationIAPILabel> LabelInfo,
+                                                                  const TSharedRef<STableViewBase> &OwnerTable) {
+    return SNew(STableRow<TSharedPtr<FGitlabIntegrationIAPILabel>>, OwnerTable)
+           [
+               GenerateLabelWidget(LabelInfo, false)
+           ];
 }
 
 TSharedRef<SHorizontalBox>
-FGitlabIntegrationModule::GenerateLabelWidget(TSharedPtr<FGitlabIntegrationIAPILabel> LabelInfo, bool OnIssue) {
-    return SNew(SHorizontalBox)
+FGitlabIntegrationModule::GenerateLabelWidget(TSharedPtr<const FGitlabIntegrationIAPILabel> LabelInfo, bool OnIssue) {
+    TSharedRef<SHorizontalBox> Widget = SNew(SHorizontalBox)
                + SHorizontalBox::Slot()
                    .AutoWidth()
                [
@@ -495,27 +653,67 @@ FGitlabIntegrationModule::GenerateLabelWidget(TSharedPtr<FGitlabIntegrationIAPIL
                            .Padding(1)
                        [
                                SNew(SButton)
-                                   .Text(FText::FromString(LabelInfo->name))
+                                   .Text_Lambda([LabelInfo, LastName = FString(), NameText = FText()]() mutable -> FText {
+                                       if (NameText.IsEmpty() || !LastName.Equals(LabelInfo->name, ESearchCase::CaseSensitive)) {
+                                           LastName = LabelInfo->name;
+                                           NameText = FText::FromString(LastName);
+                                       }
+                                       return NameText;
+                                   })
                                    .ForegroundColor_Lambda([this, LabelInfo, OnIssue]() -> FLinearColor {
-                                       return SelectedLabels.Contains(LabelInfo->name) || OnIssue ? FColor::FromHex(
-                                           LabelInfo->text_color) : FLinearColor::Black;
+                                       if (ExcludedLabels.Contains(LabelInfo->InternId)) return FLinearColor::White;
+                                       return SelectedLabels.Contains(LabelInfo->InternId) || OnIssue ? LabelInfo->TextColor
+                                                                                                      : FLinearColor::Black;
+                                   })
+                                   .ToolTipText_Lambda([LabelInfo]() -> FText {
+                                       return FText::Format(LOCTEXT("GILabelTooltip", "{0}\n\nClick to filter, Ctrl+Click to hide issues with this label"),
+                                                            FText::FromString(LabelInfo->description));
                                    })
-                                   .ToolTipText(FText::FromString(LabelInfo->description))
                                    .ButtonColorAndOpacity_Lambda([this, LabelInfo, OnIssue]() -> FLinearColor {
-                                       return SelectedLabels.Contains(LabelInfo->name) || OnIssue ? FColor::FromHex(
-                                           LabelInfo->color) : FLinearColor::Gray;
+                                       if (ExcludedLabels.Contains(LabelInfo->InternId)) return FLinearColor(0.35f, 0.05f, 0.05f);
+                                       return SelectedLabels.Contains(LabelInfo->InternId) || OnIssue ? LabelInfo->Color
+                                                                                                      : FLinearColor::Gray;
                                    })
                                    .OnClicked_Lambda([this, LabelInfo]() -> FReply {
-                                       if (SelectedLabels.Contains(LabelInfo->name))
-                                           SelectedLabels.Remove(LabelInfo->name);
-                                       else {
-                                           SelectedLabels.Add(LabelInfo->name);
+                                       const int32 Id = LabelInfo->InternId;
+                                       if (Id == INDEX_NONE) return FReply::Handled();
+                                       if (FSlateApplication::Get().GetModifierKeys().IsControlDown()) {
+                                           SelectedLabels.Remove(Id);
+                                           if (ExcludedLabels.Contains(Id)) ExcludedLabels.Remove(Id);
+                                           else ExcludedLabels.Add(Id);
+                                       } else {
+                                           ExcludedLabels.Remove(Id);
+                                           if (SelectedLabels.Contains(Id)) SelectedLabels.Remove(Id);
+                                           else SelectedLabels.Add(Id);
                                        }
-                                       RefreshIssues();
+                                       RequestIssueRefresh();
                                        return FReply::Handled();
                                    })
                        ]
                ];
+    if (!OnIssue) {
+        // Issues of the current search with this label, ignoring the label's own selection or exclusion, so a hidden
+        // label still shows how many issues it hides. The text is only rebuilt when the count changes
+        Widget->AddSlot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            .Padding(2.0f, 0.0f)
+        [
+            SNew(STextBlock)
+                .Text_Lambda([this, LabelInfo, LastCount = -1, LastTotal = -1, CountText = FText()]() mutable -> FText {
+                    const int32 Count = GetViewLabelCount(LabelInfo->InternId);
+                    const int32 Total = Api->GetLabelIssueCount(LabelInfo->InternId);
+                    if (Count != LastCount || Total != LastTotal) {
+                        LastCount = Count;
+                        LastTotal = Total;
+                        CountText = Count == Total ? FText::AsNumber(Count)
+                                                   : FText::Format(LOCTEXT("GILabelCount", "{0}/{1}"), Count, Total);
+                    }
+                    return CountText;
+                })
+        ];
+    }
+    return Widget;
 }
 
 void FGitlabIntegrationModule::FinishTimeTracking(TSharedPtr<FGitlabIntegrationIAPIIssue> issue) {
@@ -525,7 +723,7 @@ void FGitlabIntegrationModule::FinishTimeTracking(TSharedPtr<FGitlabIntegrationI
 }
 
 TSharedRef<SWidget> FGitlabIntegrationModule::CreateProjectSelectionButton() {
-    return SNew(SComboButton)
+    return SAssignNew(ProjectComboButton, SComboButton)
                    .OnGetMenuContent_Lambda([this]() { return GenerateProjectList(); })
                    .ButtonContent()
                [
@@ -542,27 +740,104 @@ TSharedRef<STextBlock> FGitlabIntegrationModule::CreateProjectSelectionButtonTex
 }
 
 TSharedRef<SWidget> FGitlabIntegrationModule::GenerateProjectList() {
-    FMenuBuilder MenuBuilder(true, nullptr);
-    for (auto &Project : Api->GetProjects()) {
-        MenuBuilder.AddMenuEntry(
-            FText::FromString(Project.name_with_namespace),
-            FText::GetEmpty(),
-            FSlateIcon(),
-            FUIAction(FExecuteAction::CreateLambda([=] {
-                          HandleProjectSelection(Project);
-                      })
-            )
-        );
+    // The project list is only needed here, it keeps filling in while the menu is open
+    Api->EnsureProjectsLoaded();
+    RefreshProjects();
+
+    return SNew(SBox)
+               .MaxDesiredHeight(400.0f)
+               .MinDesiredWidth(300.0f)
+           [
+                   SNew(SVerticalBox)
+                   + SVerticalBox::Slot()
+                       .AutoHeight()
+                       .Padding(4.0f)
+                   [
+                           SNew(STextBlock)
+                               .Text(LOCTEXT("GitlabIntegrationProjectsLoading", "Loading projects..."))
+                               .Visibility_Lambda([this]() -> EVisibility {
+                                   return Api->AreProjectsLoading() ? EVisibility::Visible : EVisibility::Collapsed;
+                               })
+                   ]
+                   + SVerticalBox::Slot()
+                   [
+                           SAssignNew(ProjectListView, SListView<TSharedPtr<FGitlabIntegrationIAPIProject>>)
+                               .ListItemsSource(&ProjectList)
+                               .SelectionMode(ESelectionMode::Single)
+                               .OnGenerateRow_Lambda(
+                                   [](TSharedPtr<FGitlabIntegrationIAPIProject> Project,
+                                      const TSharedRef<STableViewBase> &OwnerTable) -> TSharedRef<ITableRow> {
+                                       return SNew(STableRow<TSharedPtr<FGitlabIntegrationIAPIProject>>, OwnerTable)
+                                              .Padding(FMargin(4.0f, 2.0f))
+                                              [
+                                                  SNew(STextBlock).Text(FText::FromString(Project->name_with_namespace))
+                                              ];
+                                   })
+                               .OnSelectionChanged_Lambda(
+                                   [this](TSharedPtr<FGitlabIntegrationIAPIProject> Project, ESelectInfo::Type SelectInfo) {
+                                       if (Project.IsValid() && SelectInfo != ESelectInfo::Direct) {
+                                           HandleProjectSelection(*Project);
+                                           if (ProjectComboButton.IsValid()) {
+                                               ProjectComboButton->SetIsOpen(false);
+                                           }
+                                       }
+                                   })
+                   ]
+           ];
+}
+
+void FGitlabIntegrationModule::RefreshProjects() {
+    UGitlabIntegrationSettings *Settings = GetMutableDefault<UGitlabIntegrationSettings>();
+    FGitlabIntegrationIAPIProject Selected = Api->GetProject();
+    if (Settings != nullptr && Selected.id != -1 && Settings->ProjectId != Selected.id) {
+        // Remember where the project lives so the next start can look it up directly
+        Settings->ProjectId = Selected.id;
+        Settings->ProjectPath = Selected.path_with_namespace;
+        Settings->SaveConfig();
+    }
+
+    if (ProjectListVersion == Api->ProjectsVersion) return;
+    ProjectListVersion = Api->ProjectsVersion;
+    ProjectList = Api->GetProjects();
+    if (Api->IsGroupMode()) {
+        // Selecting a project of a group only filters the list, this entry shows all of them again
+        TSharedPtr<FGitlabIntegrationIAPIProject> All = MakeShareable(new FGitlabIntegrationIAPIProject());
+        All->id = -1;
+        All->name_with_namespace = LOCTEXT("GitlabIntegrationAllProjects", "All projects").ToString();
+        ProjectList.Insert(All, 0);
+    }
+    if (ProjectListView.IsValid()) {
+        ProjectListView->RequestListRefresh();
     }
-    return MenuBuilder.MakeWidget();
 }
 
 void FGitlabIntegrationModule::HandleProjectSelection(FGitlabIntegrationIAPIProject project) {
     UGitlabIntegrationSettings *Settings = GetMutableDefault<UGitlabIntegrationSettings>();
     if (Settings != nullptr) {
+        if (Api->IsGroupMode()) {
+            // The whole group stays loaded, only the view changes
+            if (ProjectFilter == project.id) return;
+            ProjectFilter = project.id;
+            if (project.id == -1) {
+                // "All projects" is no project, the settings keep the last real one
+                ProjectSelectionButtonText->SetText(FText::FromString(project.name_with_namespace));
+            } else {
+                UE_LOG(LogGitlabIntegration, Log, TEXT("Selected project %s"), *project.name_with_namespace);
+                Settings->Project = FText::FromString(project.name_with_namespace);
+                Settings->ProjectId = project.id;
+                Settings->ProjectPath = project.path_with_namespace;
+                Settings->SaveConfig();
+                Api->SetProject(project);
+                ProjectSelectionButtonText->SetText(Settings->Project);
+            }
+            RequestIssueRefresh();
+            return;
+        }
         if (Settings->Project.ToString() != project.name_with_namespace) {
             UE_LOG(LogGitlabIntegration, Log, TEXT("Selected project %s"), *project.name_with_namespace);
             Settings->Project = FText::FromString(project.name_with_namespace);
+            Settings->ProjectId = project.id;
+            Settings->ProjectPath = project.path_with_namespace;
             Settings->SaveConfig();
             Api->SetProject(project);
             if (project.id != -1) {
@@ -570,7 +845,8 @@ void FGitlabIntegrationModule::HandleProjectSelection(FGitlabIntegrationIAPIProj
             } else {
                 ProjectSelectionButtonText->SetText(LOCTEXT("GitlabIntegrationProjectSelection", "Select Project"));
             }
-            IssueList.Empty();
+            ClearIssueView();
+            IssueRows.Empty();
 
             if (IssueListView.IsValid()) {
                 IssueListView->RequestListRefresh();
@@ -631,39 +907,380 @@ void FGitlabIntegrationModule::UnregisterSettings() {
 bool FGitlabIntegrationModule::HandleSettingsSaved() {
     UGitlabIntegrationSettings *Settings = GetMutableDefault<UGitlabIntegrationSettings>();
 
-    Api->SetBaseUrl(Settings->Server);
+    const bool bServerChanged = Api->SetBaseUrl(Settings->Server);
+    if (bServerChanged) {
+        // Project ids are per server, the project is looked up again by its path
+        Settings->ProjectId = -1;
+    }
     Api->SetToken(Settings->Token);
-    Api->GetProjectsRequest(1);
+    Api->SetMaxConcurrentPages(Settings->MaxConcurrentPageRequests);
+    Api->SetRequestLimits(Settings->MaxRequestsInFlight, Settings->MaxRequestsPerSecond);
+    Api->SetIncrementalSync(Settings->IncrementalIssueSync);
+    Api->SetVerifyJsonDecoder(Settings->VerifyJsonDecoder);
+    if (Settings->Group != Api->GroupPath) {
+        Api->SetGroup(Settings->Group);
+        ProjectFilter = Api->IsGroupMode() ? Settings->ProjectId : -1;
+        ClearIssueView();
+        IssueRows.Empty();
+    } else if (Api->IsGroupMode()) {
+        if (bServerChanged) {
+            // SetBaseUrl dropped the store of the old server, the group is loaded again from the new one
+            ProjectFilter = -1;
+            Api->FetchProjectContent();
+        }
+    } else if (!Settings->ProjectPath.IsEmpty() && Settings->ProjectPath != Api->GetProject().path_with_namespace) {
+        // The path was edited by hand, the stored id belongs to the old project
+        Settings->ProjectId = -1;
+    }
+    if (!Api->IsGroupMode()) {
+        Api->SetLoadProjectLocation(Settings->ProjectId, Settings->ProjectPath);
+        if (Api->GetProject().id == -1 || Settings->ProjectId == -1) {
+            // Whatever the old project still loads is of no use while the new one is looked up
+            Api->CancelProjectRequests();
+            Api->ResolveProject();
+        }
+    }
     IssueSortNewFirst = Settings->SortIssuesNewestFirst;
+    IssueRefreshDebounce = Settings->IssueRefreshDebounceSeconds;
     Settings->SaveConfig();
-    RefreshIssues();
+    UpdateWebhookReceiver();
+    PollInterval = Settings->MinPollIntervalSeconds;
+    SchedulePoll();
+    RequestIssueRefresh();
 
     return true;
 }
 
-void FGitlabIntegrationModule::RefreshIssues() {
-    UE_LOG(LogGitlabIntegration, Verbose, TEXT("Issue Refresh triggered"));
+void FGitlabIntegrationModule::UpdateWebhookReceiver() {
+    const UGitlabIntegrationSettings *Settings = GetDefault<UGitlabIntegrationSettings>();
+    WebhookReceiver.Stop();
+    if (Settings->EnableWebhookReceiver) {
+        WebhookReceiver.Start(Api, Settings->WebhookPort, Settings->WebhookPath, Settings->WebhookSecret);
+    }
+}
 
-    for (auto &Issue : Api->GetIssues()) {
-        bool show = SelectedLabels.Num() <= 0;
-        for (auto &Label: SelectedLabels) {
-            if (Issue->labels.Contains(Label)) {
-                show = true;
+void FGitlabIntegrationModule::SchedulePoll() {
+    const UGitlabIntegrationSettings *Settings = GetDefault<UGitlabIntegrationSettings>();
+    FTicker::GetCoreTicker().RemoveTicker(PollHandle);
+    PollHandle.Reset();
+    if (!Settings->EnableBackgroundPolling) return;
+
+    // Nobody looks at the issues while the editor is in the background
+    const float Delay = FPlatformApplicationMisc::IsThisApplicationForeground()
+                            ? PollInterval : FMath::Max(PollInterval, Settings->MaxPollIntervalSeconds);
+    PollHandle = FTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FGitlabIntegrationModule::PollProjectActivity), Delay);
+}
+
+bool FGitlabIntegrationModule::PollProjectActivity(float DeltaTime) {
+    PollHandle.Reset();
+    // A group has no single activity timestamp to watch, its issues come in through the webhook or a refresh
+    if (Api->IsGroupMode() || Api->GetProject().id == -1) {
+        HandlePollResult(false);
+    } else {
+        Api->PollProjectActivity(std::bind(&FGitlabIntegrationModule::HandlePollResult, this, std::placeholders::_1));
+    }
+    return false;
+}
+
+void FGitlabIntegrationModule::HandlePollResult(bool bActivity) {
+    const UGitlabIntegrationSettings *Settings = GetDefault<UGitlabIntegrationSettings>();
+    const float MinInterval = Settings->MinPollIntervalSeconds;
+    const float MaxInterval = FMath::Max(MinInterval, Settings->MaxPollIntervalSeconds);
+    // Activity tends to come in bursts, check again soon after one and back off while the project is idle
+    PollInterval = bActivity ? MinInterval : FMath::Clamp(PollInterval * 2.0f, MinInterval, MaxInterval);
+    UE_LOG(LogGitlabIntegration, Verbose, TEXT("Project %s, next check in %.0f s"), bActivity ? TEXT("active") : TEXT("idle"), PollInterval);
+    SchedulePoll();
+}
+
+void FGitlabIntegrationModule::RequestIssueRefresh() {
+    IssueRefreshRequests++;
+    if (!bIssuesDirty) {
+        bIssuesDirty = true;
+        IssueRefreshRequestedAt = FPlatformTime::Seconds();
+    }
+}
+
+void FGitlabIntegrationModule::RequestLabelRefresh() {
+    bLabelsDirty = true;
+}
+
+bool FGitlabIntegrationModule::Tick(float DeltaTime) {
+    if (bLabelsDirty) {
+        bLabelsDirty = false;
+        RefreshLabels();
+    }
+    // Measured from the first request so a steady stream of pages or keystrokes cannot hold the view back forever
+    if (bIssuesDirty && FPlatformTime::Seconds() - IssueRefreshRequestedAt >= IssueRefreshDebounce) {
+        bIssuesDirty = false;
+        IssueRefreshesRun++;
+        RefreshIssues();
+    }
+    return true;
+}
+
+void FGitlabIntegrationModule::HandleIssueDelta(const FGitlabIntegrationIAPIIssueDelta &Delta) {
+    if (Delta.bReset) {
+        ClearIssueView();
+        IssueRows.Empty();
+    }
+    for (auto &Issue : Delta.Updated) {
+        if (FGitlabIntegrationIssueRow *Row = IssueRows.Find(Issue->id)) {
+            UpdateIssueRow(*Row, *Issue);
+        }
+    }
+    for (auto &Issue : Delta.Removed) {
+        IssueRows.Remove(Issue->id);
+    }
+    if (bIssuesDirty) {
+        // The pending rebuild picks these up
+        RequestIssueRefresh();
+        return;
+    }
+
+    for (auto &Issue : Delta.Removed) {
+        UntrackIssue(Issue);
+    }
+    // Issues are updated in place and iid never changes, so only the filter result and the facets can differ
+    for (auto &Issue : Delta.Updated) {
+        TrackIssue(Issue);
+    }
+    for (auto &Issue : Delta.Added) {
+        TrackIssue(Issue);
+    }
+
+    if (IssueListView.IsValid()) {
+        IssueListView->RequestListRefresh();
+    }
+}
+
+void FGitlabIntegrationModule::HandleLabelDelta(const FGitlabIntegrationIAPILabelDelta &Delta) {
+    if (Delta.bReset || bLabelsDirty) {
+        RequestLabelRefresh();
+    } else {
+        for (auto &Label : Delta.Removed) {
+            LabelList.Remove(Label);
+        }
+        // Updates are rare (only changed labels are reported), a rename may move the label.
+        // All of them leave the list first, the list is only sorted again once none has a stale position
+        for (auto &Label : Delta.Updated) {
+            LabelList.Remove(Label);
+        }
+        for (auto &Label : Delta.Updated) {
+            if (LabelMatches(*Label)) {
+                InsertLabel(Label);
+            }
+        }
+        for (auto &Label : Delta.Added) {
+            if (LabelMatches(*Label)) {
+                InsertLabel(Label);
+            }
+        }
+        // Tiles read the name and description through their bindings, a refresh is enough for renames
+        if (LabelTileView.IsValid()) {
+            LabelTileView->RequestListRefresh();
+        }
+    }
+    if (Delta.bReset || Delta.Added.Num() > 0 || Delta.Removed.Num() > 0) {
+        // Cached rows may show placeholders for labels which were unknown when they were built,
+        // only rows with one of the added or removed labels are filled again
+        FGitlabIntegrationIAPILabelSet Changed;
+        for (auto &Label : Delta.Added) {
+            Changed.Add(Label->InternId);
+        }
+        for (auto &Label : Delta.Removed) {
+            Changed.Add(Label->InternId);
+        }
+        for (auto &Row : IssueRows) {
+            if (!Delta.bReset && !Changed.ContainsAny(Row.Value.LabelIds)) continue;
+            if (const TSharedPtr<FGitlabIntegrationIAPIIssue> *Issue = Api->Issues.Find(Row.Key)) {
+                FillIssueRowLabels(Row.Value, **Issue);
             }
         }
-        if ((Issue->title.Contains(IssueSearch, ESearchCase::IgnoreCase, ESearchDir::FromStart) ||
-             IssueSearch.Contains(FString::Printf(TEXT("#%d"), Issue->id), ESearchCase::IgnoreCase,
-                                  ESearchDir::FromStart) || IssueSearch.TrimStart().IsEmpty()) && show) {
-            if (IssueList.Contains(Issue)) continue;
+    }
+}
+
+bool FGitlabIntegrationModule::IssueLess(const TSharedPtr<FGitlabIntegrationIAPIIssue> &A,
+                                         const TSharedPtr<FGitlabIntegrationIAPIIssue> &B) const {
+    if (A->iid != B->iid) {
+        return IssueSortNewFirst ? A->iid > B->iid : A->iid < B->iid;
+    }
+    return A->id < B->id;
+}
+
+void FGitlabIntegrationModule::InsertIssue(const TSharedPtr<FGitlabIntegrationIAPIIssue> &Issue) {
+    const int32 Index = Algo::LowerBound(IssueList, Issue,
+                                         [this](const TSharedPtr<FGitlabIntegrationIAPIIssue> &A,
+                                                const TSharedPtr<FGitlabIntegrationIAPIIssue> &B) { return IssueLess(A, B); });
+    IssueList.Insert(Issue, Index);
+}
+
+void FGitlabIntegrationModule::RemoveIssue(const TSharedPtr<FGitlabIntegrationIAPIIssue> &Issue) {
+    const int32 Index = Algo::LowerBound(IssueList, Issue,
+                                         [this](const TSharedPtr<FGitlabIntegrationIAPIIssue> &A,
+                                                const TSharedPtr<FGitlabIntegrationIAPIIssue> &B) { return IssueLess(A, B); });
+    if (IssueList.IsValidIndex(Index) && IssueList[Index]->id == Issue->id) {
+        IssueList.RemoveAt(Index);
+    }
+}
+
+void FGitlabIntegrationModule::TrackIssue(const TSharedPtr<FGitlabIntegrationIAPIIssue> &Issue) {
+    if (!IssueMatchesSearch(*Issue)) {
+        UntrackIssue(Issue);
+        return;
+    }
+    FGitlabIntegrationIssueFacets Facets;
+    const bool bInView = CollectIssueFacets(*Issue, Facets);
+    bool bWasInView = false;
+    if (FGitlabIntegrationIssueFacets *Tracked = IssueListFacets.Find(Issue->id)) {
+        bWasInView = Tracked->bInView;
+        CountIssueFacets(*Tracked, -1);
+        *Tracked = MoveTemp(Facets);
+        CountIssueFacets(*Tracked, 1);
+    } else {
+        CountIssueFacets(Facets, 1);
+        IssueListFacets.Add(Issue->id, MoveTemp(Facets));
+    }
+    if (bInView && !bWasInView) {
+        InsertIssue(Issue);
+    } else if (!bInView && bWasInView) {
+        RemoveIssue(Issue);
+    }
+}
+
+void FGitlabIntegrationModule::UntrackIssue(const TSharedPtr<FGitlabIntegrationIAPIIssue> &Issue) {
+    FGitlabIntegrationIssueFacets Facets;
+    if (!IssueListFacets.RemoveAndCopyValue(Issue->id, Facets)) return;
+    CountIssueFacets(Facets, -1);
+    if (Facets.bInView) {
+        RemoveIssue(Issue);
+    }
+}
+
+bool FGitlabIntegrationModule::CollectIssueFacets(const FGitlabIntegrationIAPIIssue &Issue, FGitlabIntegrationIssueFacets &Facets) const {
+    int32 SelectedFound = 0;
+    int32 ExcludedFound = 0;
+    for (int32 Id : Issue.LabelIds) {
+        if (SelectedLabels.Contains(Id)) SelectedFound++;
+        if (ExcludedLabels.Contains(Id)) ExcludedFound++;
+    }
+    auto SelectionMatches = [this](int32 Found, int32 Size) {
+        return Size == 0 || (LabelFilterMatchAll ? Found == Size : Found > 0);
+    };
+
+    // A label counts the issues it would show if its own selection or exclusion was not part of the filter,
+    // so selected and excluded labels still tell how many issues they narrow down or hide
+    for (int32 Id : Issue.LabelIds) {
+        const int32 Own = SelectedLabels.Contains(Id) ? 1 : 0;
+        if (ExcludedFound - (ExcludedLabels.Contains(Id) ? 1 : 0) == 0
+            && SelectionMatches(SelectedFound - Own, SelectedLabels.Num() - Own)) {
+            Facets.LabelIds.Add(Id);
+        }
+    }
+    Facets.State = FName(*Issue.state);
+    Facets.bInView = ExcludedFound == 0 && SelectionMatches(SelectedFound, SelectedLabels.Num());
+    return Facets.bInView;
+}
+
+void FGitlabIntegrationModule::CountIssueFacets(const FGitlabIntegrationIssueFacets &Facets, int32 Change) {
+    for (int32 Id : Facets.LabelIds) {
+        if (ViewLabelCounts.Num() <= Id) {
+            ViewLabelCounts.SetNumZeroed(Id + 1);
+        }
+        ViewLabelCounts[Id] += Change;
+    }
+    if (Facets.bInView) {
+        int32 &StateCount = ViewStateCounts.FindOrAdd(Facets.State);
+        StateCount += Change;
+        if (StateCount == 0) {
+            ViewStateCounts.Remove(Facets.State);
+        }
+    }
+    bIssueViewSummaryDirty = true;
+}
+
+void FGitlabIntegrationModule::ClearIssueView() {
+    IssueList.Reset();
+    IssueListFacets.Reset();
+    ViewLabelCounts.Reset();
+    ViewStateCounts.Reset();
+    bIssueViewSummaryDirty = true;
+}
+
+int32 FGitlabIntegrationModule::GetViewLabelCount(int32 InternId) const {
+    return ViewLabelCounts.IsValidIndex(InternId) ? ViewLabelCounts[InternId] : 0;
+}
+
+FText FGitlabIntegrationModule::GetIssueViewSummary() {
+    if (bIssueViewSummaryDirty) {
+        bIssueViewSummaryDirty = false;
+        FString Summary;
+        for (auto &State : ViewStateCounts) {
+            if (!Summary.IsEmpty()) Summary += TEXT(", ");
+            Summary += FString::Printf(TEXT("%d %s"), State.Value, *State.Key.ToString());
+        }
+        IssueViewSummary = FText::FromString(Summary);
+    }
+    return IssueViewSummary;
+}
+
+bool FGitlabIntegrationModule::IssueMatchesSearch(const FGitlabIntegrationIAPIIssue &Issue) const {
+    if (ProjectFilter != -1 && Issue.project_id != ProjectFilter) {
+        return false;
+    }
+    return (IssueSearchEmpty || IssueSearchNumbers.Contains(Issue.iid) ||
+                    Issue.title.Contains(IssueSearch, ESearchCase::IgnoreCase, ESearchDir::FromStart));
+}
+
+FText FGitlabIntegrationModule::GetIssueReference(const FGitlabIntegrationIAPIIssue &Issue) const {
+    const FString Reference = TEXT("#") + FString::FromInt(Issue.iid);
+    const FGitlabIntegrationIAPIProject *Project = Api->IsGroupMode() ? Api->Projects.Find(Issue.project_id) : nullptr;
+    return FText::FromString(Project != nullptr ? Project->name + Reference : Reference);
+}
+
+void FGitlabIntegrationModule::RefreshIssues() {
+    UE_LOG(LogGitlabIntegration, Verbose, TEXT("Issue Refresh triggered, %d of %d requests merged so far"),
+           IssueRefreshRequests - IssueRefreshesRun, IssueRefreshRequests);
+
+    IssueSearchEmpty = IssueSearch.TrimStart().IsEmpty();
+    IssueSearchNumbers.Reset();
+    FGitlabIntegrationIAPISearchIndex::ParseNumbers(IssueSearch, IssueSearchNumbers);
+    // Only the issues sharing every trigram with the search (or one of its #numbers) have to be checked
+    TSet<int32> Candidates;
+    const bool bIndexed = !IssueSearchEmpty && Api->SearchIndex.Query(IssueSearch, Candidates);
+
+    ClearIssueView();
+    // Every issue matching the search is counted in the label facets, only those passing the label filter are listed
+    auto AddIssue = [this](const TSharedPtr<FGitlabIntegrationIAPIIssue> &Issue) {
+        if (!IssueMatchesSearch(*Issue)) return;
+        FGitlabIntegrationIssueFacets &Facets = IssueListFacets.Add(Issue->id);
+        if (CollectIssueFacets(*Issue, Facets)) {
             IssueList.Add(Issue);
-        } else {
-            IssueList.Remove(Issue);
+        }
+        CountIssueFacets(Facets, 1);
+    };
+    if (bIndexed) {
+        for (int32 IssueId : Candidates) {
+            if (const TSharedPtr<FGitlabIntegrationIAPIIssue> *Issue = Api->Issues.Find(IssueId)) {
+                AddIssue(*Issue);
+            }
+        }
+    } else if (const TSet<int32> *ProjectIssues = ProjectFilter != -1 ? Api->GetProjectIssueIds(ProjectFilter) : nullptr) {
+        // The partition of the filtered project already knows its issues, the rest of the group is not visited
+        for (int32 IssueId : *ProjectIssues) {
+            if (const TSharedPtr<FGitlabIntegrationIAPIIssue> *Issue = Api->Issues.Find(IssueId)) {
+                AddIssue(*Issue);
+            }
+        }
+    } else {
+        for (auto &Issue : Api->Issues) {
+            AddIssue(Issue.Value);
         }
     }
 
     IssueList.Sort(
         [this](const TSharedPtr<FGitlabIntegrationIAPIIssue> &A, const TSharedPtr<FGitlabIntegrationIAPIIssue> &B) {
-            return IssueSortNewFirst ? A->iid > B->iid : A->iid < B->iid;
+            return IssueLess(A, B);
         });
 
     if (IssueListView.IsValid()) {
@@ -671,25 +1288,28 @@ void FGitlabIntegrationModule::RefreshIssues() {
     }
 }
 
-void FGitlabIntegrationModule::RefreshLabels() {
-    UE_LOG(LogGitlabIntegration, Verbose, TEXT("Label callback triggered"));
+bool FGitlabIntegrationModule::LabelMatches(const FGitlabIntegrationIAPILabel &Label) const {
+    return LabelSearch.IsEmpty() || Label.name.Contains(LabelSearch, ESearchCase::IgnoreCase, ESearchDir::FromStart);
+}
 
-    LabelList.Empty();
-    for (auto &Label: Api->GetLabels()) {
-        LabelList.Add(Label);
-    }
+void FGitlabIntegrationModule::InsertLabel(const TSharedPtr<FGitlabIntegrationIAPILabel> &Label) {
+    LabelList.Insert(Label, Algo::LowerBound(LabelList, Label, &IAPI::LabelLess));
+}
 
-    if (LabelWrapBox.IsValid()) {
-        LabelWrapBox->ClearChildren();
-        for (auto &Label: LabelList) {
+void FGitlabIntegrationModule::RefreshLabels() {
+    UE_LOG(LogGitlabIntegration, Verbose, TEXT("Label refresh triggered"));
 
-            LabelWrapBox->AddSlot()
-            [
-                GenerateLabelWidget(Label, false)
-            ];
+    // Already in LabelLess order, filtering keeps it
+    LabelList.Reset();
+    for (auto &Label: Api->GetLabels()) {
+        if (LabelMatches(*Label)) {
+            LabelList.Add(Label);
         }
     }
 
+    if (LabelTileView.IsValid()) {
+        LabelTileView->RequestListRefresh();
+    }
 }
 
 #undef LOCTEXT_NAMESPACE
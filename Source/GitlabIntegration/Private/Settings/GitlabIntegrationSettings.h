@@ -34,9 +34,111 @@ public:
     UPROPERTY(config, EditAnywhere)
     FText Project = FText::GetEmpty();
 
+    /**
+     * Path of the selected project (group/project), used to look it up directly
+     */
+    UPROPERTY(config, EditAnywhere)
+    FString ProjectPath;
+
+    /**
+     * Id of the selected project, filled in once the project has been found
+     */
+    UPROPERTY(config, VisibleAnywhere)
+    int32 ProjectId = -1;
+
+    /**
+     * Path of a group (group or group/subgroup), when set the open issues of all its projects are shown together and the selected project only narrows the list
+     */
+    UPROPERTY(config, EditAnywhere)
+    FString Group;
+
+    /**
+     * Load issues and labels through the GraphQL API, one request per page of both, and batch time tracking
+     */
+    UPROPERTY(config, EditAnywhere, meta = (ConfigRestartRequired = true))
+    bool UseGraphQLApi = false;
+
     /**
      * Sort Issues newest first
      */
     UPROPERTY(config, EditAnywhere)
     bool SortIssuesNewestFirst = true;
+
+    /**
+     * How many pages of projects, issues or labels are downloaded at the same time (1 loads them one by one)
+     */
+    UPROPERTY(config, EditAnywhere, meta = (ClampMin = "1", ClampMax = "16"))
+    int32 MaxConcurrentPageRequests = 4;
+
+    /**
+     * How many requests may be sent to the server at the same time
+     */
+    UPROPERTY(config, EditAnywhere, meta = (ClampMin = "1", ClampMax = "32"))
+    int32 MaxRequestsInFlight = 6;
+
+    /**
+     * Upper limit of requests per second, lowered automatically when the server reports its rate limit
+     */
+    UPROPERTY(config, EditAnywhere, meta = (ClampMin = "0.1", ClampMax = "100.0"))
+    float MaxRequestsPerSecond = 10.0f;
+
+    /**
+     * Refresh only downloads issues changed since the last complete load
+     */
+    UPROPERTY(config, EditAnywhere)
+    bool IncrementalIssueSync = true;
+
+    /**
+     * Decode responses a second time through reflection and log any difference (slow, for debugging)
+     */
+    UPROPERTY(config, EditAnywhere)
+    bool VerifyJsonDecoder = false;
+
+    /**
+     * Check the project for activity in the background and sync issues when there was some
+     */
+    UPROPERTY(config, EditAnywhere)
+    bool EnableBackgroundPolling = false;
+
+    /**
+     * Seconds between checks while the project is active, doubled after every check without activity
+     */
+    UPROPERTY(config, EditAnywhere, meta = (ClampMin = "10.0", ClampMax = "600.0", EditCondition = "EnableBackgroundPolling"))
+    float MinPollIntervalSeconds = 30.0f;
+
+    /**
+     * Longest time between checks, used right away while the editor is in the background
+     */
+    UPROPERTY(config, EditAnywhere, meta = (ClampMin = "60.0", ClampMax = "3600.0", EditCondition = "EnableBackgroundPolling"))
+    float MaxPollIntervalSeconds = 600.0f;
+
+    /**
+     * Listen for Gitlab issue webhooks inside the editor, changes then show up without refreshing
+     */
+    UPROPERTY(config, EditAnywhere)
+    bool EnableWebhookReceiver = false;
+
+    /**
+     * Local port the webhook receiver listens on
+     */
+    UPROPERTY(config, EditAnywhere, meta = (ClampMin = "1024", ClampMax = "65535", EditCondition = "EnableWebhookReceiver"))
+    int32 WebhookPort = 8765;
+
+    /**
+     * Path the webhook is posted to, e.g. http://<this machine>:8765/gitlab
+     */
+    UPROPERTY(config, EditAnywhere, meta = (EditCondition = "EnableWebhookReceiver"))
+    FString WebhookPath = TEXT("/gitlab");
+
+    /**
+     * Secret token of the webhook in Gitlab, events without it are refused
+     */
+    UPROPERTY(config, EditAnywhere, meta = (EditCondition = "EnableWebhookReceiver"))
+    FString WebhookSecret;
+
+    /**
+     * Seconds to wait before filtering the issue list after a change, all changes in between are applied at once (0 waits for the next frame)
+     */
+    UPROPERTY(config, EditAnywhere, meta = (ClampMin = "0.0", ClampMax = "2.0"))
+    float IssueRefreshDebounceSeconds = 0.15f;
 };
@@ -0,0 +1,220 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "../../Public/API/GitlabGraphQLAPI.h"
+#include "GitlabIntegrationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Keeps the next queries and the REST fallbacks instead of sending them */
+class FGitlabIntegrationGraphQLTestAPI : public GitlabGraphQLAPI {
+public:
+    FGitlabIntegrationGraphQLTestAPI()
+        : GitlabGraphQLAPI(FText::FromString(TEXT("https://gitlab.example.com")), FText(), FText(), nullptr, nullptr) {
+    }
+
+    ~FGitlabIntegrationGraphQLTestAPI() {
+        // Nothing may be left for the destructor to send
+        FTicker::GetCoreTicker().RemoveTicker(TimelogTickHandle);
+        TimelogTickHandle.Reset();
+        PendingTimelogs.Empty();
+    }
+
+    using GitlabGraphQLAPI::BeginIssues;
+    using GitlabGraphQLAPI::BeginLabels;
+    using GitlabGraphQLAPI::QueryDecoded;
+    using GitlabGraphQLAPI::TimelogResponse;
+    using GitlabGraphQLAPI::PendingTimelogs;
+    using GitlabGraphQLAPI::TimelogTickHandle;
+    using IAPI::Partitions;
+    using IAPI::IssueWatermarks;
+
+    TArray<FGitlabGraphQLAPIQuery> SentQueries;
+    TArray<FGitlabGraphQLAPITimelog> RestTimelogs;
+
+    /** Takes the batch RecordTimeSpent collected, like FlushTimelogs does */
+    TArray<FGitlabGraphQLAPITimelog> FlushPendingTimelogs() {
+        FTicker::GetCoreTicker().RemoveTicker(TimelogTickHandle);
+        TimelogTickHandle.Reset();
+        TArray<FGitlabGraphQLAPITimelog> Timelogs = MoveTemp(PendingTimelogs);
+        PendingTimelogs.Reset();
+        return Timelogs;
+    }
+
+private:
+    void SendQuery(const FGitlabGraphQLAPIQuery &Query) override {
+        SentQueries.Add(Query);
+    }
+
+    void RecordTimeSpentThroughRest(const FGitlabGraphQLAPITimelog &Timelog) override {
+        RestTimelogs.Add(Timelog);
+    }
+};
+
+static TSharedPtr<FGitlabIntegrationTestResponse, ESPMode::ThreadSafe> MakeGitlabIntegrationGraphQLResponse(const TArray<uint8> &Content) {
+    TSharedPtr<FGitlabIntegrationTestResponse, ESPMode::ThreadSafe> Response = MakeShared<FGitlabIntegrationTestResponse, ESPMode::ThreadSafe>();
+    Response->Url = TEXT("https://gitlab.example.com/api/graphql");
+    Response->Content = Content;
+    return Response;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGitlabIntegrationGraphQLDecodePageTest, "GitlabIntegration.GraphQL.DecodePage",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGitlabIntegrationGraphQLDecodePageTest::RunTest(const FString &Parameters) {
+    TArray<uint8> Content;
+    if (!TestTrue(TEXT("Fixture graphql_page_first.json loaded"), LoadGitlabIntegrationFixture(TEXT("graphql_page_first.json"), Content))) return false;
+    FGitlabGraphQLAPIPage First;
+    GitlabGraphQLAPI::DecodePage(Content, First);
+    TestTrue(TEXT("First page is valid"), First.bValid);
+    TestTrue(TEXT("First page has issues and labels"), First.bHasIssues && First.bHasLabels);
+    TestTrue(TEXT("More issues follow"), First.bMoreIssues);
+    TestEqual(TEXT("Issue cursor"), First.IssuesCursor,
+              FString(TEXT("eyJpZCI6IjUyODE3IiwidXBkYXRlZF9hdCI6IjIwMTktMDgtMjMgMDk6MzE6MTQuMzQ1MDAwMDAwICswMDAwIn0")));
+    TestFalse(TEXT("No more labels follow"), First.bMoreLabels);
+    if (!TestEqual(TEXT("Issues of the first page"), First.Issues.Items.Num(), 2)) return false;
+    const FGitlabIntegrationIAPIIssue &Issue = First.Issues.Items[0];
+    TestEqual(TEXT("Global id becomes the REST id"), Issue.id, 52817);
+    TestEqual(TEXT("String iid is parsed"), Issue.iid, 214);
+    TestEqual(TEXT("Issue state"), Issue.state, FString(TEXT("opened")));
+    TestEqual(TEXT("Issue url"), Issue.web_url, FString(TEXT("https://gitlab.example.com/studio/forest-level/issues/214")));
+    TestTrue(TEXT("Issue update time"), Issue.updated_at == FDateTime(2019, 8, 23, 9, 31, 14));
+    TestTrue(TEXT("Label connection becomes the label names"), Issue.labels == TArray<FString>({TEXT("bug"), TEXT("Priority::High")}));
+    if (!TestEqual(TEXT("Labels of the first page"), First.Labels.Items.Num(), 3)) return false;
+    const FGitlabIntegrationIAPILabel &Priority = First.Labels.Items[1];
+    TestEqual(TEXT("Group label id"), Priority.id, 318);
+    TestEqual(TEXT("Label title becomes the name"), Priority.name, FString(TEXT("Priority::High")));
+    TestEqual(TEXT("Null description stays empty"), Priority.description, FString());
+    TestTrue(TEXT("Label colors are parsed"), Priority.Color.Equals(FLinearColor(FColor(0xff, 0x8c, 0x00))));
+
+    if (!TestTrue(TEXT("Fixture graphql_page_last.json loaded"), LoadGitlabIntegrationFixture(TEXT("graphql_page_last.json"), Content))) return false;
+    FGitlabGraphQLAPIPage Last;
+    GitlabGraphQLAPI::DecodePage(Content, Last);
+    TestTrue(TEXT("Last page is valid"), Last.bValid);
+    TestTrue(TEXT("Last page has issues only"), Last.bHasIssues && !Last.bHasLabels);
+    TestFalse(TEXT("No more issues follow"), Last.bMoreIssues);
+    if (!TestEqual(TEXT("Issues of the last page"), Last.Issues.Items.Num(), 1)) return false;
+    TestEqual(TEXT("Issue without labels"), Last.Issues.Items[0].labels.Num(), 0);
+
+    if (!TestTrue(TEXT("Fixture graphql_error.json loaded"), LoadGitlabIntegrationFixture(TEXT("graphql_error.json"), Content))) return false;
+    FGitlabGraphQLAPIPage Error;
+    GitlabGraphQLAPI::DecodePage(Content, Error);
+    TestFalse(TEXT("Error response is not valid"), Error.bValid);
+    TestEqual(TEXT("First error message is kept"), Error.Error, FString(TEXT("Field 'timelogCreate' doesn't exist on type 'Mutation'")));
+
+    FTCHARToUTF8 Cut(TEXT("{\"data\": {\"project\": {\"issues\": "));
+    Content.Reset();
+    Content.Append((const uint8 *) Cut.Get(), Cut.Length());
+    FGitlabGraphQLAPIPage Truncated;
+    GitlabGraphQLAPI::DecodePage(Content, Truncated);
+    TestFalse(TEXT("Truncated response is not valid"), Truncated.bValid);
+    TestEqual(TEXT("Truncated response is reported"), Truncated.Error, FString(TEXT("malformed response")));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGitlabIntegrationGraphQLCursorPagingTest, "GitlabIntegration.GraphQL.CursorPaging",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGitlabIntegrationGraphQLCursorPagingTest::RunTest(const FString &Parameters) {
+    TArray<uint8> FirstContent;
+    TArray<uint8> LastContent;
+    TArray<uint8> ErrorContent;
+    if (!TestTrue(TEXT("Fixture graphql_page_first.json loaded"), LoadGitlabIntegrationFixture(TEXT("graphql_page_first.json"), FirstContent))) return false;
+    if (!TestTrue(TEXT("Fixture graphql_page_last.json loaded"), LoadGitlabIntegrationFixture(TEXT("graphql_page_last.json"), LastContent))) return false;
+    if (!TestTrue(TEXT("Fixture graphql_error.json loaded"), LoadGitlabIntegrationFixture(TEXT("graphql_error.json"), ErrorContent))) return false;
+
+    FGitlabIntegrationGraphQLTestAPI Api;
+    Api.SelectedProject.id = 1842;
+    Api.SelectedProject.path_with_namespace = TEXT("studio/forest-level");
+    auto Deliver = [&Api](const TArray<uint8> &Content, const FGitlabGraphQLAPIQuery &Query) {
+        TSharedPtr<FGitlabGraphQLAPIPage> Page = MakeShared<FGitlabGraphQLAPIPage>();
+        GitlabGraphQLAPI::DecodePage(Content, *Page);
+        Api.QueryDecoded(MakeGitlabIntegrationGraphQLResponse(Content), Page, Query);
+    };
+
+    // A full load of issues and labels in one query
+    FGitlabGraphQLAPIQuery Query;
+    Api.BeginIssues(Query, EGitlabIntegrationIAPIRequestPriority::Foreground, false);
+    Api.BeginLabels(Query, EGitlabIntegrationIAPIRequestPriority::Foreground);
+    Deliver(FirstContent, Query);
+    if (!TestTrue(TEXT("Fetch has its partition"), Api.Partitions.Contains(1842))) return false;
+    TestEqual(TEXT("First page issues are merged"), Api.Issues.Num(), 2);
+    TestEqual(TEXT("Labels are merged"), Api.Labels.Num(), 3);
+    if (!TestEqual(TEXT("Next page is asked for"), Api.SentQueries.Num(), 1)) return false;
+    const FGitlabGraphQLAPIQuery Next = Api.SentQueries[0];
+    TestTrue(TEXT("Issues continue"), Next.bIssues);
+    TestEqual(TEXT("Issues continue after the cursor"), Next.IssuesCursor,
+              FString(TEXT("eyJpZCI6IjUyODE3IiwidXBkYXRlZF9hdCI6IjIwMTktMDgtMjMgMDk6MzE6MTQuMzQ1MDAwMDAwICswMDAwIn0")));
+    TestFalse(TEXT("Labels without more pages are left out"), Next.bLabels);
+    TestEqual(TEXT("Next page belongs to the same fetch"), Next.IssuesSerial, Query.IssuesSerial);
+    TestTrue(TEXT("Issues are still loading"), Api.Partitions.Find(1842)->bLoading);
+
+    Deliver(LastContent, Next);
+    TestEqual(TEXT("Last page issues are merged"), Api.Issues.Num(), 3);
+    TestEqual(TEXT("Nothing is asked for after the last page"), Api.SentQueries.Num(), 1);
+    TestFalse(TEXT("Issues are loaded"), Api.Partitions.Find(1842)->bLoading);
+    TestTrue(TEXT("Completed fetch sets the watermark"), Api.IssueWatermarks.FindRef(1842) == FDateTime(2019, 8, 23, 9, 31, 14));
+
+    // A page of an earlier fetch is dropped
+    FGitlabGraphQLAPIQuery Restarted;
+    Api.BeginIssues(Restarted, EGitlabIntegrationIAPIRequestPriority::Foreground, false);
+    Deliver(FirstContent, Next);
+    TestEqual(TEXT("Stale page asks for nothing"), Api.SentQueries.Num(), 1);
+    TestTrue(TEXT("Restarted fetch is still loading"), Api.Partitions.Find(1842)->bLoading);
+
+    // An error ends the fetch and keeps what was loaded
+    Deliver(ErrorContent, Restarted);
+    TestEqual(TEXT("Failed page asks for nothing"), Api.SentQueries.Num(), 1);
+    TestFalse(TEXT("Failed fetch is not loading"), Api.Partitions.Find(1842)->bLoading);
+    TestFalse(TEXT("Failed fetch drops the watermark"), Api.IssueWatermarks.Contains(1842));
+    TestEqual(TEXT("Failed fetch keeps the issues"), Api.Issues.Num(), 3);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGitlabIntegrationGraphQLTimelogFallbackTest, "GitlabIntegration.GraphQL.TimelogFallback",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGitlabIntegrationGraphQLTimelogFallbackTest::RunTest(const FString &Parameters) {
+    TArray<uint8> ErrorContent;
+    TArray<uint8> TimelogContent;
+    if (!TestTrue(TEXT("Fixture graphql_error.json loaded"), LoadGitlabIntegrationFixture(TEXT("graphql_error.json"), ErrorContent))) return false;
+    if (!TestTrue(TEXT("Fixture graphql_timelog.json loaded"), LoadGitlabIntegrationFixture(TEXT("graphql_timelog.json"), TimelogContent))) return false;
+
+    FGitlabIntegrationGraphQLTestAPI Api;
+    TSharedPtr<FGitlabIntegrationIAPIIssue> Crash = MakeShared<FGitlabIntegrationIAPIIssue>();
+    Crash->id = 52817;
+    Crash->iid = 214;
+    Crash->project_id = 1842;
+    TSharedPtr<FGitlabIntegrationIAPIIssue> Foliage = MakeShared<FGitlabIntegrationIAPIIssue>();
+    Foliage->id = 52790;
+    Foliage->iid = 209;
+    Foliage->project_id = 1842;
+
+    // Entries of a moment go out together
+    Api.RecordTimeSpent(Crash, 1500);
+    Api.RecordTimeSpent(Foliage, 300);
+    TestTrue(TEXT("Flush is scheduled"), Api.TimelogTickHandle.IsValid());
+    TArray<FGitlabGraphQLAPITimelog> Batch = Api.FlushPendingTimelogs();
+    if (!TestEqual(TEXT("Both entries are batched"), Batch.Num(), 2)) return false;
+    TestEqual(TEXT("Batched issue"), Batch[1].IssueId, 52790);
+    TestEqual(TEXT("Batched time"), Batch[1].Seconds, 300);
+
+    // A server without timelogCreate rejects the whole document, every entry goes through REST
+    Api.TimelogResponse(nullptr, MakeGitlabIntegrationGraphQLResponse(ErrorContent), true, Batch);
+    if (!TestEqual(TEXT("Every entry falls back to REST"), Api.RestTimelogs.Num(), 2)) return false;
+    TestTrue(TEXT("REST call keeps the issue"), Api.RestTimelogs[0].Issue == Crash && Api.RestTimelogs[1].Issue == Foliage);
+    TestEqual(TEXT("REST call keeps the time"), Api.RestTimelogs[0].Seconds, 1500);
+
+    // Errors of single entries are only logged, the server did take the document
+    Api.RestTimelogs.Empty();
+    Api.TimelogResponse(nullptr, MakeGitlabIntegrationGraphQLResponse(TimelogContent), true, Batch);
+    TestEqual(TEXT("Accepted document is not sent again"), Api.RestTimelogs.Num(), 0);
+
+    // A failed request is not retried through REST either, it may have been recorded
+    Api.TimelogResponse(nullptr, nullptr, false, Batch);
+    TestEqual(TEXT("Failed request is not sent again"), Api.RestTimelogs.Num(), 0);
+    return true;
+}
+
+#endif
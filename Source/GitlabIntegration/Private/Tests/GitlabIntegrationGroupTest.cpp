@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "../../Public/GitlabIntegration.h"
+#include "../../Public/API/IAPIJsonReader.h"
+#include "../Settings/GitlabIntegrationSettings.h"
+#include "GitlabIntegrationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static const int32 GitlabIntegrationForestProject = 1842;
+static const int32 GitlabIntegrationRiverProject = 1907;
+
+/** A group store with two projects, loaded with a full page each like the group fetch does */
+static bool LoadGitlabIntegrationGroup(FAutomationTestBase &Test, FGitlabIntegrationTestAPI &Api) {
+    TArray<uint8> Fixture;
+    TArray<FGitlabIntegrationIAPIIssue> Recorded;
+    if (!Test.TestTrue(TEXT("Fixture issues.json loaded"), LoadGitlabIntegrationFixture(TEXT("issues.json"), Fixture))) return false;
+    if (!Test.TestTrue(TEXT("Recorded issues decode"), FGitlabIntegrationIAPIJsonDecoder::DecodeArray(Fixture, Recorded) && Recorded.Num() >= 6)) return false;
+
+    Api.GroupPath = TEXT("studio");
+    for (int32 ProjectId : {GitlabIntegrationForestProject, GitlabIntegrationRiverProject}) {
+        FGitlabIntegrationIAPIIssuePartition &Partition = Api.Partitions.Add(ProjectId);
+        Partition.bLoading = true;
+        Partition.bFull = true;
+        Partition.PendingWatermark = FDateTime::FromUnixTimestamp(0);
+    }
+    // Four issues of the forest and two of the river, ids and iids made unique across the group
+    TGitlabIntegrationIAPIDecodedArray<FGitlabIntegrationIAPIIssue> ForestPage;
+    TGitlabIntegrationIAPIDecodedArray<FGitlabIntegrationIAPIIssue> RiverPage;
+    for (int32 Index = 0; Index < 6; Index++) {
+        FGitlabIntegrationIAPIIssue Issue = Recorded[Index];
+        Issue.id = 70000 + Index;
+        Issue.iid = Index + 1;
+        Issue.state = TEXT("opened");
+        Issue.project_id = Index < 4 ? GitlabIntegrationForestProject : GitlabIntegrationRiverProject;
+        (Index < 4 ? ForestPage : RiverPage).Items.Add(MoveTemp(Issue));
+    }
+    Api.MergeIssuesPage(Api.Partitions[GitlabIntegrationForestProject], ForestPage);
+    Api.MergeIssuesPage(Api.Partitions[GitlabIntegrationRiverProject], RiverPage);
+    Api.CompleteIssueFetch(GitlabIntegrationForestProject);
+    Api.CompleteIssueFetch(GitlabIntegrationRiverProject);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGitlabIntegrationGroupPartitionsTest, "GitlabIntegration.Group.Partitions",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGitlabIntegrationGroupPartitionsTest::RunTest(const FString &Parameters) {
+    FGitlabIntegrationTestAPI Api;
+    if (!LoadGitlabIntegrationGroup(*this, Api)) return false;
+    TestEqual(TEXT("The group is one store"), Api.Issues.Num(), 6);
+    const TSet<int32> *Forest = Api.GetProjectIssueIds(GitlabIntegrationForestProject);
+    const TSet<int32> *River = Api.GetProjectIssueIds(GitlabIntegrationRiverProject);
+    if (!TestTrue(TEXT("Each project has its partition"), Forest != nullptr && River != nullptr)) return false;
+    TestEqual(TEXT("Forest issues"), Forest->Num(), 4);
+    TestEqual(TEXT("River issues"), River->Num(), 2);
+    TestTrue(TEXT("An issue is in its own project's partition"), River->Contains(70004) && !Forest->Contains(70004));
+    TestTrue(TEXT("Unknown project has no partition"), Api.GetProjectIssueIds(4711) == nullptr);
+
+    // A full load of one project only reconciles that project
+    FGitlabIntegrationIAPIIssuePartition &Partition = Api.Partitions[GitlabIntegrationRiverProject];
+    Partition.bLoading = true;
+    Partition.bFull = true;
+    Partition.PendingWatermark = FDateTime::FromUnixTimestamp(0);
+    Partition.SeenIds.Empty();
+    TGitlabIntegrationIAPIDecodedArray<FGitlabIntegrationIAPIIssue> RiverPage;
+    RiverPage.Items.Add(*Api.Issues[70005]);
+    Api.MergeIssuesPage(Partition, RiverPage);
+    Api.CompleteIssueFetch(GitlabIntegrationRiverProject);
+    TestFalse(TEXT("Issue the project's load did not see is dropped"), Api.Issues.Contains(70004));
+    TestEqual(TEXT("Its partition forgets it"), River->Num(), 1);
+    TestEqual(TEXT("The other project keeps its issues"), Forest->Num(), 4);
+    TestEqual(TEXT("Store holds both projects"), Api.Issues.Num(), 5);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGitlabIntegrationGroupViewTest, "GitlabIntegration.Group.ProjectFilter",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGitlabIntegrationGroupViewTest::RunTest(const FString &Parameters) {
+    // A module of its own, the one of the editor keeps its store and tab
+    FGitlabIntegrationModule Module;
+    FGitlabIntegrationTestAPI Api;
+    Module.Api = &Api;
+    Module.IssueSortNewFirst = true;
+    Api.SetIssueCallback([&Module](const FGitlabIntegrationIAPIIssueDelta &Delta) { Module.HandleIssueDelta(Delta); });
+    auto ListedProjects = [&Module]() {
+        TSet<int32> ProjectIds;
+        for (const TSharedPtr<FGitlabIntegrationIAPIIssue> &Issue : Module.IssueList) {
+            ProjectIds.Add(Issue->project_id);
+        }
+        return ProjectIds;
+    };
+
+    // The saved project narrows the issues as they arrive
+    Module.ProjectFilter = GitlabIntegrationForestProject;
+    if (!LoadGitlabIntegrationGroup(*this, Api)) return false;
+    TestEqual(TEXT("Only the forest is listed"), Module.IssueList.Num(), 4);
+    TestTrue(TEXT("Listed issues are of the forest"), ListedProjects().Num() == 1 && ListedProjects().Contains(GitlabIntegrationForestProject));
+
+    // A rebuild visits only the filtered project's partition
+    Module.ProjectFilter = GitlabIntegrationRiverProject;
+    Module.RefreshIssues();
+    TestEqual(TEXT("Only the river is listed"), Module.IssueList.Num(), 2);
+    TestTrue(TEXT("Listed issues are of the river"), ListedProjects().Num() == 1 && ListedProjects().Contains(GitlabIntegrationRiverProject));
+
+    // The pseudo entry clears the filter without touching the settings
+    UGitlabIntegrationSettings *Settings = GetMutableDefault<UGitlabIntegrationSettings>();
+    const FString SavedProject = Settings->Project.ToString();
+    const int32 SavedProjectId = Settings->ProjectId;
+    const FString SavedProjectPath = Settings->ProjectPath;
+    const int32 SelectedProjectId = Api.GetProject().id;
+    Module.CreateProjectSelectionButtonText();
+    FGitlabIntegrationIAPIProject All;
+    All.id = -1;
+    All.name_with_namespace = TEXT("All projects");
+    Module.HandleProjectSelection(All);
+    TestEqual(TEXT("Filter is cleared"), Module.ProjectFilter, -1);
+    TestEqual(TEXT("Project name is not saved"), Settings->Project.ToString(), SavedProject);
+    TestEqual(TEXT("Project id is not saved"), Settings->ProjectId, SavedProjectId);
+    TestEqual(TEXT("Project path is not saved"), Settings->ProjectPath, SavedProjectPath);
+    TestEqual(TEXT("Store keeps its project"), Api.GetProject().id, SelectedProjectId);
+    TestEqual(TEXT("Button shows the entry"), Module.ProjectSelectionButtonText->GetText().ToString(), FString(TEXT("All projects")));
+
+    // The rebuild is left to the next tick
+    TestTrue(TEXT("Selection asks for a rebuild"), Module.bIssuesDirty);
+    Module.Tick(0.0f);
+    TestEqual(TEXT("The whole group is listed"), Module.IssueList.Num(), 6);
+    TestEqual(TEXT("Both projects are listed"), ListedProjects().Num(), 2);
+
+    // Picking it again changes nothing
+    Module.HandleProjectSelection(All);
+    TestFalse(TEXT("Same selection asks for no rebuild"), Module.bIssuesDirty);
+    Api.SetIssueCallback(nullptr);
+    return true;
+}
+
+#endif
@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/MemoryBase.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Interfaces/IPluginManager.h"
+#include "Interfaces/IHttpResponse.h"
+#include "../../Public/API/GitlabAPI.h"
+
+/** Recorded server responses and webhook payloads, in Private/Tests/Fixtures */
+inline bool LoadGitlabIntegrationFixture(const FString &Name, TArray<uint8> &Out) {
+    TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("GitlabIntegration"));
+    if (!Plugin.IsValid()) return false;
+    const FString Path = Plugin->GetBaseDir() / TEXT("Source/GitlabIntegration/Private/Tests/Fixtures") / Name;
+    return FFileHelper::LoadFileToArray(Out, *Path, FILEREAD_Silent);
+}
+
+inline FString LoadGitlabIntegrationFixtureString(const FString &Name) {
+    TArray<uint8> Content;
+    if (!LoadGitlabIntegrationFixture(Name, Content)) return FString();
+    FUTF8ToTCHAR Converted((const ANSICHAR *) Content.GetData(), Content.Num());
+    return FString(Converted.Length(), Converted.Get());
+}
+
+/** Store of a GitlabAPI which never talks to its server, the tests drive the merges themselves */
+class FGitlabIntegrationTestAPI : public GitlabAPI {
+public:
+    FGitlabIntegrationTestAPI()
+        : GitlabAPI(FText::FromString(TEXT("https://gitlab.example.com")), FText(), FText(), nullptr, nullptr) {
+    }
+
+    using IAPI::MergeIssues;
+    using IAPI::MergeIssuesPage;
+    using IAPI::CompleteIssueFetch;
+    using IAPI::MergeLabels;
+    using IAPI::Partitions;
+};
+
+/** A recorded response handed to the response handlers as if it came from the server */
+class FGitlabIntegrationTestResponse : public IHttpResponse {
+public:
+    FString Url;
+    int32 Code = EHttpResponseCodes::Ok;
+    TArray<uint8> Content;
+
+    FString GetURL() override { return Url; }
+    FString GetURLParameter(const FString &ParameterName) override { return FString(); }
+    FString GetHeader(const FString &HeaderName) override { return FString(); }
+    TArray<FString> GetAllHeaders() override { return TArray<FString>(); }
+    FString GetContentType() override { return TEXT("application/json"); }
+    int32 GetContentLength() override { return Content.Num(); }
+    const TArray<uint8> &GetContent() override { return Content; }
+    int32 GetResponseCode() override { return Code; }
+
+    FString GetContentAsString() override {
+        FUTF8ToTCHAR Converted((const ANSICHAR *) Content.GetData(), Content.Num());
+        return FString(Converted.Length(), Converted.Get());
+    }
+};
+
+struct FGitlabIntegrationAllocationCount {
+    int64 Allocations = 0;
+    int64 Bytes = 0;
+};
+
+/**
+ * Sits in front of GMalloc while allocations are counted and forwards everything. Only the thread doing the
+ * measured work is counted, the task graph, the HTTP thread and the renderer keep allocating meanwhile.
+ */
+class FGitlabIntegrationCountingMalloc final : public FMalloc {
+public:
+    FMalloc *Inner = nullptr;
+    uint32 ThreadId = 0;
+    int64 Allocations = 0;
+    int64 Bytes = 0;
+
+    void *Malloc(SIZE_T Count, uint32 Alignment) override {
+        Record(Count);
+        return Inner->Malloc(Count, Alignment);
+    }
+
+    void *Realloc(void *Original, SIZE_T Count, uint32 Alignment) override {
+        // A growing TArray reallocates, that is counted like a new block
+        if (Count > 0) {
+            Record(Count);
+        }
+        return Inner->Realloc(Original, Count, Alignment);
+    }
+
+    void Free(void *Original) override {
+        Inner->Free(Original);
+    }
+
+    bool GetAllocationSize(void *Original, SIZE_T &SizeOut) override {
+        return Inner->GetAllocationSize(Original, SizeOut);
+    }
+
+    SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override {
+        return Inner->QuantizeSize(Count, Alignment);
+    }
+
+    bool IsInternallyThreadSafe() const override {
+        return Inner->IsInternallyThreadSafe();
+    }
+
+    const TCHAR *GetDescriptiveName() override {
+        return TEXT("GitlabIntegrationCounting");
+    }
+
+private:
+    void Record(SIZE_T Size) {
+        // Only the measuring thread writes the counters, no atomics needed
+        if (FPlatformTLS::GetCurrentThreadId() != ThreadId) return;
+        Allocations++;
+        Bytes += (int64) Size;
+    }
+};
+
+/** Counts the heap allocations Work makes on the calling thread */
+inline FGitlabIntegrationAllocationCount CountGitlabIntegrationAllocations(TFunctionRef<void()> Work) {
+    // One proxy for all calls, it outlives the measurement since other threads may still be inside it
+    static FGitlabIntegrationCountingMalloc Counting;
+    Counting.Inner = GMalloc;
+    Counting.ThreadId = FPlatformTLS::GetCurrentThreadId();
+    Counting.Allocations = 0;
+    Counting.Bytes = 0;
+    FPlatformMisc::MemoryBarrier();
+    GMalloc = &Counting;
+    FPlatformMisc::MemoryBarrier();
+    Work();
+    GMalloc = Counting.Inner;
+    FPlatformMisc::MemoryBarrier();
+
+    FGitlabIntegrationAllocationCount Result;
+    Result.Allocations = Counting.Allocations;
+    Result.Bytes = Counting.Bytes;
+    return Result;
+}
+
+#endif
@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "../../Public/API/IAPIJsonReader.h"
+#include "GitlabIntegrationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Elements of a recorded array response, the recordings hold one element per line */
+static TArray<TArray<uint8>> SplitGitlabIntegrationFixture(const TArray<uint8> &Fixture) {
+    TArray<TArray<uint8>> Elements;
+    int32 First = INDEX_NONE;
+    int32 Last = INDEX_NONE;
+    Fixture.Find('[', First);
+    Fixture.FindLast(']', Last);
+    if (First == INDEX_NONE || Last <= First) return Elements;
+
+    int32 Start = First + 1;
+    for (int32 Index = Start; Index <= Last; Index++) {
+        if (Index == Last || (Fixture[Index] == '\n' && Index > Start)) {
+            int32 End = Index;
+            while (End > Start && (Fixture[End - 1] == ',' || Fixture[End - 1] == '\n' || Fixture[End - 1] == '\r')) End--;
+            if (End > Start) {
+                Elements.Emplace(Fixture.GetData() + Start, End - Start);
+            }
+            Start = Index + 1;
+        }
+    }
+    return Elements;
+}
+
+/** A full page built by repeating the elements of a recorded response */
+static TArray<uint8> MakeGitlabIntegrationPage(const TArray<uint8> &Fixture, int32 Items) {
+    const TArray<TArray<uint8>> Elements = SplitGitlabIntegrationFixture(Fixture);
+    TArray<uint8> Page;
+    if (Elements.Num() == 0) return Page;
+
+    Page.Add('[');
+    for (int32 Index = 0; Index < Items; Index++) {
+        if (Index > 0) Page.Add(',');
+        Page.Append(Elements[Index % Elements.Num()]);
+    }
+    Page.Add(']');
+    return Page;
+}
+
+template <typename StructType>
+static void CheckGitlabIntegrationDecoderParity(FAutomationTestBase &Test, const TCHAR *Fixture) {
+    TArray<uint8> Recorded;
+    if (!Test.TestTrue(FString::Printf(TEXT("Fixture %s loaded"), Fixture), LoadGitlabIntegrationFixture(Fixture, Recorded))) return;
+
+    TArray<StructType> Streamed;
+    TArray<StructType> Reflected;
+    Test.TestTrue(FString::Printf(TEXT("%s: field table decodes"), Fixture), FGitlabIntegrationIAPIJsonDecoder::DecodeArray(Recorded, Streamed));
+    Test.TestTrue(FString::Printf(TEXT("%s: FJsonObjectConverter decodes"), Fixture), FGitlabIntegrationIAPIJsonDecoder::DecodeArrayWithReflection(Recorded, Reflected));
+    if (!Test.TestEqual(FString::Printf(TEXT("%s: element count"), Fixture), Streamed.Num(), Reflected.Num())) return;
+    Test.TestTrue(FString::Printf(TEXT("%s: not empty"), Fixture), Streamed.Num() > 0);
+    for (int32 Index = 0; Index < Streamed.Num(); Index++) {
+        Test.TestTrue(FString::Printf(TEXT("%s: element %d is the same with both decoders"), Fixture, Index),
+                      StructType::StaticStruct()->CompareScriptStruct(&Streamed[Index], &Reflected[Index], 0));
+    }
+
+    // Single object responses go through DecodeObject
+    const TArray<TArray<uint8>> Elements = SplitGitlabIntegrationFixture(Recorded);
+    for (int32 Index = 0; Index < Elements.Num(); Index++) {
+        StructType StreamedObject;
+        StructType ReflectedObject;
+        Test.TestTrue(FString::Printf(TEXT("%s: object %d decodes"), Fixture, Index),
+                      FGitlabIntegrationIAPIJsonDecoder::DecodeObject(Elements[Index], StreamedObject)
+                      && FGitlabIntegrationIAPIJsonDecoder::DecodeObjectWithReflection(Elements[Index], ReflectedObject));
+        Test.TestTrue(FString::Printf(TEXT("%s: object %d is the same with both decoders"), Fixture, Index),
+                      StructType::StaticStruct()->CompareScriptStruct(&StreamedObject, &ReflectedObject, 0));
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGitlabIntegrationJsonDecoderParityTest, "GitlabIntegration.Json.DecoderParity",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGitlabIntegrationJsonDecoderParityTest::RunTest(const FString &Parameters) {
+    CheckGitlabIntegrationDecoderParity<FGitlabIntegrationIAPIProject>(*this, TEXT("projects.json"));
+    CheckGitlabIntegrationDecoderParity<FGitlabIntegrationIAPIIssue>(*this, TEXT("issues.json"));
+    CheckGitlabIntegrationDecoderParity<FGitlabIntegrationIAPILabel>(*this, TEXT("labels.json"));
+    return true;
+}
+
+template <typename StructType>
+static void BenchmarkGitlabIntegrationDecoders(FAutomationTestBase &Test, const TCHAR *Fixture) {
+    TArray<uint8> Recorded;
+    if (!Test.TestTrue(FString::Printf(TEXT("Fixture %s loaded"), Fixture), LoadGitlabIntegrationFixture(Fixture, Recorded))) return;
+    const TArray<uint8> Page = MakeGitlabIntegrationPage(Recorded, IAPI::PageSize);
+    const int32 Iterations = 50;
+
+    auto DecodeStreaming = [&Page]() {
+        TArray<StructType> Items;
+        FGitlabIntegrationIAPIJsonDecoder::DecodeArray(Page, Items);
+        return Items.Num();
+    };
+    auto DecodeReflection = [&Page]() {
+        TArray<StructType> Items;
+        FGitlabIntegrationIAPIJsonDecoder::DecodeArrayWithReflection(Page, Items);
+        return Items.Num();
+    };
+    Test.TestEqual(TEXT("Streaming decoder reads the whole page"), DecodeStreaming(), (int32) IAPI::PageSize);
+    Test.TestEqual(TEXT("Reflection decoder reads the whole page"), DecodeReflection(), (int32) IAPI::PageSize);
+
+    // Timed without the allocation counter, which would slow both down
+    double Start = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++) {
+        DecodeStreaming();
+    }
+    const double StreamingMs = (FPlatformTime::Seconds() - Start) * 1000.0 / Iterations;
+    Start = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++) {
+        DecodeReflection();
+    }
+    const double ReflectionMs = (FPlatformTime::Seconds() - Start) * 1000.0 / Iterations;
+
+    const FGitlabIntegrationAllocationCount Streaming = CountGitlabIntegrationAllocations([&]() { DecodeStreaming(); });
+    const FGitlabIntegrationAllocationCount Reflection = CountGitlabIntegrationAllocations([&]() { DecodeReflection(); });
+
+    Test.AddInfo(FString::Printf(TEXT("%s, %d items, %d bytes: streaming %.3f ms, %lld allocations, %lld bytes; FJsonObjectConverter %.3f ms, %lld allocations, %lld bytes"),
+                                 Fixture, (int32) IAPI::PageSize, Page.Num(), StreamingMs, Streaming.Allocations, Streaming.Bytes,
+                                 ReflectionMs, Reflection.Allocations, Reflection.Bytes));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGitlabIntegrationJsonDecoderBenchmarkTest, "GitlabIntegration.Json.DecoderBenchmark",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FGitlabIntegrationJsonDecoderBenchmarkTest::RunTest(const FString &Parameters) {
+    BenchmarkGitlabIntegrationDecoders<FGitlabIntegrationIAPIProject>(*this, TEXT("projects.json"));
+    BenchmarkGitlabIntegrationDecoders<FGitlabIntegrationIAPIIssue>(*this, TEXT("issues.json"));
+    BenchmarkGitlabIntegrationDecoders<FGitlabIntegrationIAPILabel>(*this, TEXT("labels.json"));
+    return true;
+}
+
+#endif
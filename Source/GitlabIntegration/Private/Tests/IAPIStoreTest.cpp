@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "../../Public/API/IAPIJsonReader.h"
+#include "GitlabIntegrationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Distinct open issues made from the recorded ones, as the full load of a large project brings them */
+static TArray<FGitlabIntegrationIAPIIssue> MakeGitlabIntegrationIssueLoad(const TArray<FGitlabIntegrationIAPIIssue> &Recorded, int32 Count) {
+    TArray<FGitlabIntegrationIAPIIssue> Load;
+    Load.Reserve(Count);
+    for (int32 Index = 0; Index < Count; Index++) {
+        Load.Add(Recorded[Index % Recorded.Num()]);
+        FGitlabIntegrationIAPIIssue &Issue = Load.Last();
+        Issue.id = 1000000 + Index;
+        Issue.iid = Index + 1;
+        Issue.state = TEXT("opened");
+        Issue.title += FString::Printf(TEXT(" %d"), Index);
+    }
+    return Load;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGitlabIntegrationIssueLoadAllocationsTest, "GitlabIntegration.Store.IssueLoadAllocations",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FGitlabIntegrationIssueLoadAllocationsTest::RunTest(const FString &Parameters) {
+    TArray<uint8> Fixture;
+    TArray<FGitlabIntegrationIAPIIssue> Recorded;
+    if (!TestTrue(TEXT("Fixture issues.json loaded"), LoadGitlabIntegrationFixture(TEXT("issues.json"), Fixture))) return false;
+    if (!TestTrue(TEXT("Recorded issues decode"), FGitlabIntegrationIAPIJsonDecoder::DecodeArray(Fixture, Recorded) && Recorded.Num() > 0)) return false;
+
+    const int32 IssueCount = 10000;
+    TArray<TSharedPtr<FGitlabIntegrationIAPIIssue>> Stored;
+    Stored.Reserve(IssueCount);
+
+    // Each strategy gets a fresh load, made before counting starts, and Stored never grows while counted
+    TArray<FGitlabIntegrationIAPIIssue> Items = MakeGitlabIntegrationIssueLoad(Recorded, IssueCount);
+    const FGitlabIntegrationAllocationCount Copied = CountGitlabIntegrationAllocations([&]() {
+        for (FGitlabIntegrationIAPIIssue &Issue : Items) {
+            Stored.Add(MakeShareable(new FGitlabIntegrationIAPIIssue(Issue)));
+        }
+    });
+    Stored.Reset();
+
+    Items = MakeGitlabIntegrationIssueLoad(Recorded, IssueCount);
+    const FGitlabIntegrationAllocationCount Moved = CountGitlabIntegrationAllocations([&]() {
+        for (FGitlabIntegrationIAPIIssue &Issue : Items) {
+            Stored.Add(MakeShared<FGitlabIntegrationIAPIIssue>(MoveTemp(Issue)));
+        }
+    });
+    Stored.Reset();
+
+    // One reference count per issue, the issue bodies share their slabs
+    Items = MakeGitlabIntegrationIssueLoad(Recorded, IssueCount);
+    TGitlabIntegrationIAPISlabPool<FGitlabIntegrationIAPIIssue> Pool;
+    const FGitlabIntegrationAllocationCount Pooled = CountGitlabIntegrationAllocations([&]() {
+        for (FGitlabIntegrationIAPIIssue &Issue : Items) {
+            Stored.Add(Pool.Add(MoveTemp(Issue)));
+        }
+    });
+    TestEqual(TEXT("Pooled issues keep their content"), Stored[IssueCount - 1]->iid, IssueCount);
+    Stored.Reset();
+    Pool.Empty();
+
+    // The whole merge, with the search index, label counts and the delta
+    FGitlabIntegrationTestAPI Api;
+    Items = MakeGitlabIntegrationIssueLoad(Recorded, IssueCount);
+    const FGitlabIntegrationAllocationCount Merged = CountGitlabIntegrationAllocations([&]() { Api.MergeIssues(Items); });
+    TestEqual(TEXT("Every issue is stored"), Api.Issues.Num(), IssueCount);
+
+    AddInfo(FString::Printf(TEXT("%d issues, copied into own objects: %lld allocations, %lld bytes"), IssueCount, Copied.Allocations, Copied.Bytes));
+    AddInfo(FString::Printf(TEXT("%d issues, moved into MakeShared objects: %lld allocations, %lld bytes"), IssueCount, Moved.Allocations, Moved.Bytes));
+    AddInfo(FString::Printf(TEXT("%d issues, moved into slabs: %lld allocations, %lld bytes"), IssueCount, Pooled.Allocations, Pooled.Bytes));
+    AddInfo(FString::Printf(TEXT("%d issues, MergeIssues: %lld allocations, %lld bytes, %d slabs"), IssueCount, Merged.Allocations,
+                            Merged.Bytes, Api.IssuePool.GetSlabCount()));
+
+    // A closed issue leaves the store, the delta still holds it
+    TSharedPtr<FGitlabIntegrationIAPIIssue> First = Api.Issues.FindRef(1000000);
+    TArray<FGitlabIntegrationIAPIIssue> Closed;
+    Closed.Add(*First);
+    Closed[0].state = TEXT("closed");
+    Api.MergeIssues(Closed);
+    TestFalse(TEXT("Closed issue is removed"), Api.Issues.Contains(1000000));
+    TestEqual(TEXT("Removed issue stays readable"), First->iid, 1);
+    return true;
+}
+
+/** Counts its destructions, to see when the pool destroys an item */
+struct FGitlabIntegrationPooledItem {
+    static int32 Destroyed;
+    int32 Value = 0;
+    FString Text;
+
+    FGitlabIntegrationPooledItem(int32 InValue) : Value(InValue), Text(FString::Printf(TEXT("Item %d"), InValue)) {}
+    FGitlabIntegrationPooledItem(FGitlabIntegrationPooledItem &&Other) = default;
+    ~FGitlabIntegrationPooledItem() { Destroyed++; }
+};
+
+int32 FGitlabIntegrationPooledItem::Destroyed = 0;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGitlabIntegrationSlabPoolReuseTest, "GitlabIntegration.Store.SlabPoolReuse",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGitlabIntegrationSlabPoolReuseTest::RunTest(const FString &Parameters) {
+    TGitlabIntegrationIAPISlabPool<FGitlabIntegrationPooledItem, 4> Pool;
+    TArray<TSharedPtr<FGitlabIntegrationPooledItem>> Held;
+    for (int32 Index = 0; Index < 8; Index++) {
+        FGitlabIntegrationPooledItem Item(Index);
+        Held.Add(Pool.Add(MoveTemp(Item)));
+    }
+    TestEqual(TEXT("Eight items fill two slabs"), Pool.SlabsAllocated, 2);
+
+    // Destroyed as soon as the last holder lets go, not when the whole slab does
+    FGitlabIntegrationPooledItem::Destroyed = 0;
+    TSharedPtr<FGitlabIntegrationPooledItem> StillShown = Held[1];
+    const FGitlabIntegrationPooledItem *FreedAt = Held[0].Get();
+    Held[0].Reset();
+    Held[1].Reset();
+    TestEqual(TEXT("Item nobody holds is destroyed"), FGitlabIntegrationPooledItem::Destroyed, 1);
+    TestEqual(TEXT("Item still held stays readable"), StillShown->Text, FString(TEXT("Item 1")));
+
+    // The free slot is taken before another slab is allocated
+    TSharedPtr<FGitlabIntegrationPooledItem> Reused = Pool.Add(FGitlabIntegrationPooledItem(100));
+    TestTrue(TEXT("Freed slot is reused"), Reused.Get() == FreedAt);
+    TestEqual(TEXT("No slab for the reused slot"), Pool.SlabsAllocated, 2);
+    TestEqual(TEXT("Reused slot holds the new item"), Reused->Value, 100);
+
+    // A slab whose items are all gone is filled again
+    StillShown.Reset();
+    for (int32 Index = 2; Index < 4; Index++) {
+        Held[Index].Reset();
+    }
+    Reused.Reset();
+    for (int32 Index = 0; Index < 5; Index++) {
+        Held.Add(Pool.Add(FGitlabIntegrationPooledItem(200 + Index)));
+    }
+    TestEqual(TEXT("Empty slab is refilled instead of a new one"), Pool.SlabsAllocated, 3);
+
+    // Items outlive the pool
+    TSharedPtr<FGitlabIntegrationPooledItem> Last = Held.Last();
+    Pool.Empty();
+    Held.Empty();
+    TestEqual(TEXT("Item outlives the pool"), Last->Value, 204);
+    FGitlabIntegrationPooledItem::Destroyed = 0;
+    Last.Reset();
+    TestEqual(TEXT("Last item is destroyed with its slab"), FGitlabIntegrationPooledItem::Destroyed, 1);
+    return true;
+}
+
+#endif
@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "HttpServerResponse.h"
+#include "../../Public/API/IAPIWebhookReceiver.h"
+#include "GitlabIntegrationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGitlabIntegrationWebhookReceiverTest, "GitlabIntegration.Webhook.IssueEvents",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGitlabIntegrationWebhookReceiverTest::RunTest(const FString &Parameters) {
+    FGitlabIntegrationTestAPI Api;
+    Api.Partitions.Add(1842);
+    FGitlabIntegrationIAPIIssueDelta IssueDelta;
+    FGitlabIntegrationIAPILabelDelta LabelDelta;
+    Api.SetIssueCallback([&IssueDelta](const FGitlabIntegrationIAPIIssueDelta &Delta) { IssueDelta = Delta; });
+    Api.SetLabelCallback([&LabelDelta](const FGitlabIntegrationIAPILabelDelta &Delta) { LabelDelta = Delta; });
+
+    // Set up like Start would, without binding a port
+    const FString Secret = TEXT("forest-hook-secret");
+    FGitlabIntegrationIAPIWebhookReceiver Receiver;
+    Receiver.Api = &Api;
+    Receiver.Secret = Secret;
+
+    // Recorded Issue Hook bodies of one issue, opened, retitled, labelled and closed
+    auto Send = [this, &Receiver, &IssueDelta, &LabelDelta](const FString &Fixture, const FString &Token, const FString &Event) {
+        IssueDelta = FGitlabIntegrationIAPIIssueDelta();
+        LabelDelta = FGitlabIntegrationIAPILabelDelta();
+        FHttpServerRequest Request;
+        Request.Verb = EHttpServerRequestVerbs::VERB_POST;
+        Request.Headers.Add(TEXT("X-Gitlab-Token"), TArray<FString>{Token});
+        Request.Headers.Add(TEXT("X-Gitlab-Event"), TArray<FString>{Event});
+        TestTrue(FString::Printf(TEXT("Fixture %s loaded"), *Fixture), LoadGitlabIntegrationFixture(Fixture, Request.Body));
+        EHttpServerResponseCodes Code = EHttpServerResponseCodes::Unknown;
+        Receiver.HandleRequest(Request, [&Code](TUniquePtr<FHttpServerResponse> &&Response) { Code = Response->Code; });
+        return Code;
+    };
+    const int32 IssueId = 52900;
+
+    // A wrong token of the right length is refused just the same
+    TestTrue(TEXT("Wrong token is denied"),
+             Send(TEXT("webhook_issue_open.json"), TEXT("forest-hook-secreT"), TEXT("Issue Hook")) == EHttpServerResponseCodes::Denied);
+    TestTrue(TEXT("Missing token is denied"),
+             Send(TEXT("webhook_issue_open.json"), FString(), TEXT("Issue Hook")) == EHttpServerResponseCodes::Denied);
+    TestFalse(TEXT("Refused event is not applied"), Api.Issues.Contains(IssueId));
+    TestEqual(TEXT("Refused events are counted"), Receiver.EventsRefused, 2);
+
+    // No time is made up for an event without a readable updated_at, it would move the sync watermark
+    TestTrue(TEXT("Unreadable updated_at is rejected"),
+             Send(TEXT("webhook_issue_bad_timestamp.json"), Secret, TEXT("Issue Hook")) == EHttpServerResponseCodes::BadRequest);
+    TestFalse(TEXT("Rejected event is not applied"), Api.Issues.Contains(IssueId));
+
+    TestTrue(TEXT("Open is accepted"), Send(TEXT("webhook_issue_open.json"), Secret, TEXT("Issue Hook")) == EHttpServerResponseCodes::Ok);
+    const TSharedPtr<FGitlabIntegrationIAPIIssue> Issue = Api.Issues.FindRef(IssueId);
+    if (!TestTrue(TEXT("Opened issue is stored"), Issue.IsValid())) return false;
+    TestEqual(TEXT("Opened issue iid"), Issue->iid, 231);
+    TestEqual(TEXT("Opened issue state"), Issue->state, FString(TEXT("opened")));
+    TestEqual(TEXT("Opened issue url"), Issue->web_url, FString(TEXT("https://gitlab.example.com/studio/forest-level/issues/231")));
+    TestTrue(TEXT("Webhook timestamps are parsed"), Issue->updated_at == FDateTime(2019, 8, 23, 9, 31, 14));
+    TestTrue(TEXT("Opened issue labels"), Issue->labels == TArray<FString>{TEXT("bug")});
+    TestEqual(TEXT("Opened issue is added"), IssueDelta.Added.Num(), 1);
+    TestEqual(TEXT("Its label is added"), LabelDelta.Added.Num(), 1);
+    const TSharedPtr<FGitlabIntegrationIAPILabel> Bug = Api.Labels.FindRef(311);
+    if (!TestTrue(TEXT("Label of the event is stored"), Bug.IsValid())) return false;
+    TestEqual(TEXT("Label without text_color gets the default"), Bug->text_color, FString(TEXT("#FFFFFF")));
+    TestTrue(TEXT("Label color is parsed"), Bug->Color.Equals(FLinearColor(FColor(0xd9, 0x53, 0x4f))));
+
+    TestTrue(TEXT("Update is accepted"), Send(TEXT("webhook_issue_update.json"), Secret, TEXT("Issue Hook")) == EHttpServerResponseCodes::Ok);
+    TestEqual(TEXT("Title is updated in place"), Issue->title, FString(TEXT("Streaming volume keeps loading after it is deleted in PIE")));
+    TestTrue(TEXT("Updated issue is the stored one"), IssueDelta.Updated.Num() == 1 && IssueDelta.Updated[0] == Issue);
+    TestTrue(TEXT("Unchanged labels are not reported"), LabelDelta.IsEmpty());
+
+    TestTrue(TEXT("Label change is accepted"), Send(TEXT("webhook_issue_labels.json"), Secret, TEXT("Issue Hook")) == EHttpServerResponseCodes::Ok);
+    TestEqual(TEXT("Issue has both labels"), Issue->labels.Num(), 2);
+    TestEqual(TEXT("New label is added"), LabelDelta.Added.Num(), 1);
+    const TSharedPtr<FGitlabIntegrationIAPILabel> Priority = Api.Labels.FindRef(318);
+    if (!TestTrue(TEXT("New label is stored"), Priority.IsValid())) return false;
+    TestEqual(TEXT("New label counts the issue"), Api.GetLabelIssueCount(Priority->InternId), 1);
+    TestEqual(TEXT("Labelled issue is updated"), IssueDelta.Updated.Num(), 1);
+
+    TestTrue(TEXT("Close is accepted"), Send(TEXT("webhook_issue_close.json"), Secret, TEXT("Issue Hook")) == EHttpServerResponseCodes::Ok);
+    TestFalse(TEXT("Closed issue leaves the store"), Api.Issues.Contains(IssueId));
+    TestTrue(TEXT("Closed issue is removed"), IssueDelta.Removed.Num() == 1 && IssueDelta.Removed[0] == Issue);
+    TestEqual(TEXT("Closed issue no longer counts for its labels"), Api.GetLabelIssueCount(Priority->InternId), 0);
+
+    // Other events are acknowledged so that Gitlab keeps the hook enabled, but not applied
+    TestTrue(TEXT("Other events are acknowledged"), Send(TEXT("webhook_issue_open.json"), Secret, TEXT("Push Hook")) == EHttpServerResponseCodes::Ok);
+    TestFalse(TEXT("Other events are not applied"), Api.Issues.Contains(IssueId));
+    TestEqual(TEXT("Applied events are counted"), Receiver.EventsApplied, 4);
+
+    // A group only shows the labels its own fetch lists, the event updates those and adds none
+    FGitlabIntegrationTestAPI GroupApi;
+    GroupApi.GroupPath = TEXT("studio");
+    GroupApi.Partitions.Add(1842);
+    TArray<FGitlabIntegrationIAPILabel> GroupLabels;
+    FGitlabIntegrationIAPILabel &Known = GroupLabels[GroupLabels.AddDefaulted()];
+    Known.id = 311;
+    Known.name = TEXT("bug");
+    Known.color = TEXT("#000000");
+    Known.text_color = TEXT("#FFFFFF");
+    GroupApi.MergeLabels(GroupLabels);
+    Receiver.Api = &GroupApi;
+    TestTrue(TEXT("Group event is accepted"), Send(TEXT("webhook_issue_labels.json"), Secret, TEXT("Issue Hook")) == EHttpServerResponseCodes::Ok);
+    TestTrue(TEXT("Group event stores the issue"), GroupApi.Issues.Contains(IssueId));
+    TestFalse(TEXT("Label outside the group fetch is not added"), GroupApi.Labels.Contains(318));
+    const TSharedPtr<FGitlabIntegrationIAPILabel> GroupBug = GroupApi.Labels.FindRef(311);
+    TestTrue(TEXT("Known label is updated"), GroupBug.IsValid() && GroupBug->color == TEXT("#d9534f"));
+    return true;
+}
+
+#endif
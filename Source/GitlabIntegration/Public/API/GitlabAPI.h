@@ -23,7 +23,7 @@ public:
 	GitlabAPI();
 	~GitlabAPI();
 
-    GitlabAPI(FText base, FText token, FText LoadProject, std::function<void()> IssueCallback, std::function<void()> LabelCallback);
+    GitlabAPI(FText base, FText token, FText LoadProject, FGitlabIntegrationIAPIIssueCallback IssueCallback, FGitlabIntegrationIAPILabelCallback LabelCallback);
 
-    void SetBaseUrl(FText server);
+    bool SetBaseUrl(FText server);
 };
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "GitlabAPI.h"
+
+/** Where the next request of a GraphQL fetch continues, a part is left out once it has no more pages */
+struct FGitlabGraphQLAPIQuery {
+    int32 ProjectId = -1;
+    FString FullPath;
+    EGitlabIntegrationIAPIRequestPriority Priority = EGitlabIntegrationIAPIRequestPriority::Foreground;
+
+    bool bIssues = false;
+    int32 IssuesSerial = 0;
+    FString IssuesCursor;
+    /** Only issues updated after this, of any state, empty for a full load of the open ones */
+    FString UpdatedAfter;
+
+    bool bLabels = false;
+    int32 LabelsSerial = 0;
+    FString LabelsCursor;
+};
+
+/** One decoded GraphQL page, issues and labels in the layout the REST merges expect */
+struct FGitlabGraphQLAPIPage : public FGitlabIntegrationIAPIDecodedPayload {
+    bool bValid = false;
+    FString Error;
+    bool bHasIssues = false;
+    TGitlabIntegrationIAPIDecodedArray<FGitlabIntegrationIAPIIssue> Issues;
+    bool bMoreIssues = false;
+    FString IssuesCursor;
+    bool bHasLabels = false;
+    TGitlabIntegrationIAPIDecodedArray<FGitlabIntegrationIAPILabel> Labels;
+    bool bMoreLabels = false;
+    FString LabelsCursor;
+
+    FGitlabIntegrationIAPIDecodedPayload *Clone() const override {
+        return new FGitlabGraphQLAPIPage(*this);
+    }
+};
+
+struct FGitlabGraphQLAPITimelog {
+    int32 IssueId = -1;
+    int32 Seconds = 0;
+    /** For the REST fallback */
+    TSharedPtr<FGitlabIntegrationIAPIIssue> Issue;
+};
+
+/**
+ * Loads issues and labels of the selected project through the GraphQL API. One query asks for a page of both,
+ * with cursors instead of page numbers, and only for the fields the issue list shows. Time spent is collected
+ * for a moment and sent as one request with a mutation per entry. Everything else uses the REST API.
+ */
+class GITLABINTEGRATION_API GitlabGraphQLAPI: public GitlabAPI {
+public:
+    GitlabGraphQLAPI(FText base, FText token, FText LoadProject, FGitlabIntegrationIAPIIssueCallback IssueCallback, FGitlabIntegrationIAPILabelCallback LabelCallback);
+    ~GitlabGraphQLAPI();
+
+    bool SetBaseUrl(FText server) override;
+
+    void FetchProjectContent(EGitlabIntegrationIAPIRequestPriority Priority) override;
+    void FetchProjectIssues(EGitlabIntegrationIAPIRequestPriority Priority) override;
+    void FetchProjectIssueChanges(EGitlabIntegrationIAPIRequestPriority Priority) override;
+    void FetchProjectLabels(EGitlabIntegrationIAPIRequestPriority Priority) override;
+    void RecordTimeSpent(TSharedPtr<FGitlabIntegrationIAPIIssue> issue, int time) override;
+
+    /** Decodes a query response, public for the decode task */
+    static void DecodePage(const TArray<uint8> &Content, FGitlabGraphQLAPIPage &Out);
+
+private:
+    /** Drives the responses in without a server */
+    friend class FGitlabIntegrationGraphQLTestAPI;
+
+    FString GraphQLUrl;
+
+    /** Time spent waits this long for more entries before being sent */
+    static constexpr float TimelogBatchDelay = 2.0f;
+    TArray<FGitlabGraphQLAPITimelog> PendingTimelogs;
+    FDelegateHandle TimelogTickHandle;
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> GraphQLRequest(const FString &Query, const TSharedRef<FJsonObject> &Variables);
+    void BeginIssues(FGitlabGraphQLAPIQuery &Query, EGitlabIntegrationIAPIRequestPriority Priority, bool bChanges);
+    void BeginLabels(FGitlabGraphQLAPIQuery &Query, EGitlabIntegrationIAPIRequestPriority Priority);
+    /** Virtual so that the tests see the next page asked for instead of a request going out */
+    virtual void SendQuery(const FGitlabGraphQLAPIQuery &Query);
+    void QueryResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FGitlabGraphQLAPIQuery Query);
+    void QueryDecoded(FHttpResponsePtr Response, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed, const FGitlabGraphQLAPIQuery &Query);
+
+    bool FlushTimelogs(float DeltaTime);
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> TimelogRequest(const TArray<FGitlabGraphQLAPITimelog> &Timelogs);
+    void TimelogResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TArray<FGitlabGraphQLAPITimelog> Timelogs);
+    /** Same for the REST call of an entry the server did not take */
+    virtual void RecordTimeSpentThroughRest(const FGitlabGraphQLAPITimelog &Timelog);
+};
@@ -8,7 +8,12 @@
 #include "Json.h"
 #include "JsonUtilities.h"
 #include "Internationalization/Text.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
 #include <functional>
+#include "IAPISearchIndex.h"
+#include "IAPISlabPool.h"
+#include "IAPIRequestScheduler.h"
 #include "IAPI.generated.h"
 
 /**
@@ -21,12 +26,76 @@ struct FGitlabIntegrationIAPIProject {
     UPROPERTY() int id;
     UPROPERTY() FString name;
     UPROPERTY() FString name_with_namespace;
+    UPROPERTY() FString path_with_namespace;
     UPROPERTY() FDateTime last_activity_at;
 
     FGitlabIntegrationIAPIProject() {
         id=-1;
         last_activity_at=FDateTime::FromUnixTimestamp(0);
     }
+
+    friend FArchive& operator<<(FArchive &Ar, FGitlabIntegrationIAPIProject &Project) {
+        return Ar << Project.id << Project.name << Project.name_with_namespace << Project.path_with_namespace
+                  << Project.last_activity_at;
+    }
+};
+
+/** Interned label ids of an issue, sorted */
+typedef TArray<int32, TInlineAllocator<4>> FGitlabIntegrationIAPILabelIds;
+
+/**
+ * Bitset over interned label ids, used for label filters
+ */
+struct FGitlabIntegrationIAPILabelSet {
+    void Add(int32 Id) {
+        if (Id < 0 || Contains(Id)) return;
+        const int32 Word = Id >> 6;
+        if (Words.Num() <= Word) {
+            Words.SetNumZeroed(Word + 1);
+        }
+        Words[Word] |= 1ull << (Id & 63);
+        Count++;
+    }
+
+    void Remove(int32 Id) {
+        if (!Contains(Id)) return;
+        Words[Id >> 6] &= ~(1ull << (Id & 63));
+        Count--;
+    }
+
+    bool Contains(int32 Id) const {
+        const int32 Word = Id >> 6;
+        return Id >= 0 && Word < Words.Num() && (Words[Word] & (1ull << (Id & 63))) != 0;
+    }
+
+    bool IsEmpty() const { return Count == 0; }
+    int32 Num() const { return Count; }
+
+    void Empty() {
+        Words.Reset();
+        Count = 0;
+    }
+
+    /** True if any of the ids is in the set */
+    bool ContainsAny(const FGitlabIntegrationIAPILabelIds &Ids) const {
+        for (int32 Id : Ids) {
+            if (Contains(Id)) return true;
+        }
+        return false;
+    }
+
+    /** True if every id of the set is among the ids */
+    bool IsSubsetOf(const FGitlabIntegrationIAPILabelIds &Ids) const {
+        int32 Found = 0;
+        for (int32 Id : Ids) {
+            if (Contains(Id)) Found++;
+        }
+        return Found == Count;
+    }
+
+private:
+    TArray<uint64, TInlineAllocator<4>> Words;
+    int32 Count = 0;
 };
 
 USTRUCT()
@@ -39,20 +108,20 @@ struct FGitlabIntegrationIAPIIssue {
     UPROPERTY() int project_id;
     UPROPERTY() int iid;
     UPROPERTY() TArray<FString> labels;
+    UPROPERTY() FDateTime updated_at;
+    /** labels as interned ids, filled in when the issue is stored */
+    FGitlabIntegrationIAPILabelIds LabelIds;
 
     FGitlabIntegrationIAPIIssue() {
         id=-1;
         project_id=-1;
         iid=-1;
+        updated_at=FDateTime::FromUnixTimestamp(0);
     }
-    FGitlabIntegrationIAPIIssue(FGitlabIntegrationIAPIIssue &old) {
-        id=old.id;
-        title=old.title;
-        state=old.state;
-        labels=old.labels;
-        project_id=old.project_id;
-        iid=old.iid;
-        web_url=old.web_url;
+
+    friend FArchive& operator<<(FArchive &Ar, FGitlabIntegrationIAPIIssue &Issue) {
+        return Ar << Issue.id << Issue.title << Issue.state << Issue.web_url << Issue.project_id << Issue.iid
+                  << Issue.labels << Issue.updated_at;
     }
 };
 
@@ -64,19 +133,141 @@ struct FGitlabIntegrationIAPILabel {
     UPROPERTY() FString color;
     UPROPERTY() FString text_color;
     UPROPERTY() FString description;
+    /** Interned id of the name, filled in when the label is stored */
+    int32 InternId;
+    /** color and text_color parsed when the label is stored */
+    FLinearColor Color;
+    FLinearColor TextColor;
 
     FGitlabIntegrationIAPILabel() {
         id=-1;
+        InternId=INDEX_NONE;
+        Color=FLinearColor::Gray;
+        TextColor=FLinearColor::White;
+    }
+
+    /** Compares the fields sent by the server */
+    bool HasSameContent(const FGitlabIntegrationIAPILabel &Other) const {
+        return id == Other.id && name.Equals(Other.name, ESearchCase::CaseSensitive) &&
+               color.Equals(Other.color, ESearchCase::CaseSensitive) &&
+               text_color.Equals(Other.text_color, ESearchCase::CaseSensitive) &&
+               description.Equals(Other.description, ESearchCase::CaseSensitive);
+    }
+
+    friend FArchive& operator<<(FArchive &Ar, FGitlabIntegrationIAPILabel &Label) {
+        return Ar << Label.id << Label.name << Label.color << Label.text_color << Label.description;
+    }
+};
+
+/** Parsed body of a response, owned by whoever merges it so the items can be moved into the store */
+struct FGitlabIntegrationIAPIDecodedPayload {
+    virtual ~FGitlabIntegrationIAPIDecodedPayload() {}
+    /** Copy for the response cache, nullptr if the payload cannot be copied and the body is kept instead */
+    virtual FGitlabIntegrationIAPIDecodedPayload *Clone() const { return nullptr; }
+};
+
+/**
+ * State of a paged list download. The first page tells us how many pages there are (X-Total-Pages),
+ * the remaining pages are then requested concurrently and merged back in page order.
+ */
+struct FGitlabIntegrationIAPIPagedFetch {
+    /** Incremented on every restart so responses of an abandoned fetch can be ignored */
+    int32 Serial = 0;
+    /** Total number of pages, 0 while unknown or when falling back to following X-Next-Page */
+    int32 TotalPages = 0;
+    int32 NextPageToRequest = 2;
+    int32 NextPageToMerge = 1;
+    int32 InFlight = 0;
+    /** Decoded pages which arrived ahead of NextPageToMerge, invalid pointer for failed pages */
+    TMap<int32, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload>> PendingPages;
+    /** Priority of every page request of the fetch */
+    EGitlabIntegrationIAPIRequestPriority Priority = EGitlabIntegrationIAPIRequestPriority::Foreground;
+
+    void Restart(EGitlabIntegrationIAPIRequestPriority InPriority) {
+        Serial++;
+        Priority = InPriority;
+        TotalPages = 0;
+        NextPageToRequest = 2;
+        NextPageToMerge = 1;
+        InFlight = 1;
+        PendingPages.Empty();
+    }
+};
+
+/**
+ * The issues of one project within the store and the state of their download. A single project is a store with
+ * one partition, a group has one per project, each loaded, reconciled and given a watermark on its own.
+ */
+struct FGitlabIntegrationIAPIIssuePartition {
+    FGitlabIntegrationIAPIPagedFetch Fetch;
+    /** Between the start of a fetch and its end */
+    bool bLoading = false;
+    /** Newest updated_at seen by the running fetch, becomes the watermark once it finishes */
+    FDateTime PendingWatermark;
+    /** A full load removes whatever it did not see, this reconciles data loaded from the cache */
+    bool bFull = false;
+    TSet<int32> SeenIds;
+    /** Ids of the stored issues of the project */
+    TSet<int32> IssueIds;
+};
+
+template <typename StructType>
+struct TGitlabIntegrationIAPIDecodedArray : public FGitlabIntegrationIAPIDecodedPayload {
+    TArray<StructType> Items;
+
+    FGitlabIntegrationIAPIDecodedPayload *Clone() const override {
+        return new TGitlabIntegrationIAPIDecodedArray(*this);
     }
-    FGitlabIntegrationIAPILabel(FGitlabIntegrationIAPILabel &old) {
-        id=old.id;
-        name=old.name;
-        color=old.color;
-        text_color=old.text_color;
-        description=old.description;
+};
+
+typedef TSharedPtr<const FGitlabIntegrationIAPIDecodedPayload, ESPMode::ThreadSafe> FGitlabIntegrationIAPICachedPayload;
+
+/** Body decoded on a worker thread, handed back to the game thread through a queue */
+struct FGitlabIntegrationIAPIDecodedBody {
+    int32 DecodeId = 0;
+    TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed;
+    /** Untouched copy of Parsed for the response cache, only made when the response has validators */
+    FGitlabIntegrationIAPICachedPayload CacheCopy;
+};
+
+typedef TFunction<void(FHttpResponsePtr, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload>)> FGitlabIntegrationIAPIDecodedCallback;
+/** Runs on a worker thread, must only use what it captured by value */
+typedef TFunction<FGitlabIntegrationIAPIDecodedPayload *(const FString &Url, const TArray<uint8> &Content)> FGitlabIntegrationIAPIDecoder;
+
+/** Validators and body of the last successful GET of an url */
+struct FGitlabIntegrationIAPICacheEntry {
+    FString ETag;
+    FString LastModified;
+    /** Decoded page, never modified, a 304 hands out a copy of it. Shared with the decode task. */
+    FGitlabIntegrationIAPICachedPayload Parsed;
+    /** Body of responses stored without a decoded page, decoded again for a 304 */
+    TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Content;
+    /** Pagination headers, a 304 does not repeat them */
+    TMap<FString, FString> Headers;
+};
+
+/**
+ * What a merge changed in the issue or label store. Updated items were modified in place, removed items are
+ * no longer in the store but still carry their last state.
+ */
+template <typename ItemType>
+struct TGitlabIntegrationIAPIDelta {
+    /** The store was emptied before the items below were added (project switch, cache load) */
+    bool bReset = false;
+    TArray<TSharedPtr<ItemType>> Added;
+    TArray<TSharedPtr<ItemType>> Updated;
+    TArray<TSharedPtr<ItemType>> Removed;
+
+    bool IsEmpty() const {
+        return !bReset && Added.Num() == 0 && Updated.Num() == 0 && Removed.Num() == 0;
     }
 };
 
+typedef TGitlabIntegrationIAPIDelta<FGitlabIntegrationIAPIIssue> FGitlabIntegrationIAPIIssueDelta;
+typedef TGitlabIntegrationIAPIDelta<FGitlabIntegrationIAPILabel> FGitlabIntegrationIAPILabelDelta;
+typedef std::function<void(const FGitlabIntegrationIAPIIssueDelta &)> FGitlabIntegrationIAPIIssueCallback;
+typedef std::function<void(const FGitlabIntegrationIAPILabelDelta &)> FGitlabIntegrationIAPILabelCallback;
+
 DECLARE_LOG_CATEGORY_EXTERN(LogGitlabIntegrationIAPI, Log, All);
 
 class GITLABINTEGRATION_API IAPI {
@@ -84,21 +275,49 @@ public:
     IAPI();
 	virtual ~IAPI();
 
-    IAPI(FText base, FText token, FText LoadProject, std::function<void()> IssueCallback, std::function<void()> LabelCallback);
-	virtual void SetBaseUrl(FText base);
+    IAPI(FText base, FText token, FText LoadProject, FGitlabIntegrationIAPIIssueCallback IssueCallback, FGitlabIntegrationIAPILabelCallback LabelCallback);
+	/** False if the server did not change, otherwise the store of the previous server is dropped */
+	virtual bool SetBaseUrl(FText base);
     void SetToken(FText token);
     void SetLoadProject(FText project);
-    void SetIssueCallback(std::function<void()> callback);
-    void SetLabelCallback(std::function<void()> callback);
+    void SetLoadProjectLocation(int32 ProjectId, FString ProjectPath);
+    /** Group whose projects are loaded together instead of the selected project, empty for a single project */
+    void SetLoadGroup(FString Path);
+    /** Switches to or from the group at runtime, the store is reloaded */
+    void SetGroup(FString Path);
+    bool IsGroupMode() const { return !GroupPath.IsEmpty(); }
+    void SetProjectCallback(std::function<void()> callback);
+    void SetIssueCallback(FGitlabIntegrationIAPIIssueCallback callback);
+    void SetLabelCallback(FGitlabIntegrationIAPILabelCallback callback);
     void SetProject(FGitlabIntegrationIAPIProject project);
+    void SetMaxConcurrentPages(int32 MaxPages);
+    void SetIncrementalSync(bool Incremental);
+    void SetVerifyJsonDecoder(bool Verify);
+    void SetCacheFile(FString Filename);
+    bool LoadCache();
+    void SaveCache();
     FGitlabIntegrationIAPIProject GetProject();
 
 
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> RequestWithRoute(FString Subroute);
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> GetRequest(FString Subroute, int32 page);
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> PostRequest(FString Subroute, FString ContentJsonString);
-    void Send(TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request);
+    void Send(TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request,
+              EGitlabIntegrationIAPIRequestPriority Priority = EGitlabIntegrationIAPIRequestPriority::Foreground,
+              const FGitlabIntegrationIAPICancellationTokenPtr &Token = nullptr);
+    void SetRequestLimits(int32 MaxInFlight, float RequestsPerSecond);
     bool ResponseIsValid(FHttpResponsePtr Response, bool bWasSuccessful);
+    FString GetResponseHeader(FHttpResponsePtr Response, const FString &Name);
+    /**
+     * Decodes a json array response on a worker thread, a 304 from the cached body, and calls back on the game
+     * thread. Failed responses are called back right away. Nothing is called back once the token is cancelled.
+     */
+    template <typename StructType>
+    void DecodeResponse(FHttpResponsePtr Response, const FGitlabIntegrationIAPICancellationTokenPtr &Token,
+                        FGitlabIntegrationIAPIDecodedCallback Callback);
+    /** Same for any body, Decoder turns it into the payload handed to the callback */
+    void DecodeResponseWith(FHttpResponsePtr Response, const FGitlabIntegrationIAPICancellationTokenPtr &Token,
+                            FGitlabIntegrationIAPIDecoder Decoder, FGitlabIntegrationIAPIDecodedCallback Callback);
     template <typename StructType>
     void GetJsonStringFromStruct(StructType FilledStruct, FString& StringOutput);
     template <typename StructType>
@@ -106,8 +325,12 @@ public:
     FText ApiBaseUrl = FText::GetEmpty();
     FText ApiToken = FText::GetEmpty();
     FText InitialProjectName = FText::GetEmpty();
-    std::function<void()> IssueCallback;
-    std::function<void()> LabelCallback;
+    int32 InitialProjectId = -1;
+    FString InitialProjectPath;
+    FString GroupPath;
+    std::function<void()> ProjectCallback;
+    FGitlabIntegrationIAPIIssueCallback IssueCallback;
+    FGitlabIntegrationIAPILabelCallback LabelCallback;
 
     TMap<int32, FGitlabIntegrationIAPIProject> Projects;
     FGitlabIntegrationIAPIProject SelectedProject;
@@ -115,30 +338,196 @@ public:
     TMap<int32, TSharedPtr<FGitlabIntegrationIAPIIssue>> Issues;
     TMap<int32, TSharedPtr<FGitlabIntegrationIAPILabel>> Labels;
     TMap<FString, TSharedPtr<FGitlabIntegrationIAPILabel>> StringLabels;
+    /** Where the objects of Issues and Labels live, each is destroyed in its slot once nobody holds it */
+    TGitlabIntegrationIAPISlabPool<FGitlabIntegrationIAPIIssue> IssuePool;
+    TGitlabIntegrationIAPISlabPool<FGitlabIntegrationIAPILabel> LabelPool;
+    /** Bumped on every change of Projects, Issues and Labels, equal versions mean nothing changed */
+    uint32 ProjectsVersion = 0;
+    uint32 IssuesVersion = 0;
+    uint32 LabelsVersion = 0;
+    /** Kept in sync with Issues for the issue search box */
+    FGitlabIntegrationIAPISearchIndex SearchIndex;
+
+    /** Label names are interned into small ids which stay valid for the lifetime of the API */
+    int32 InternLabel(const FString &Name);
+    const FString &GetLabelName(int32 InternId) const;
+    void InternIssueLabels(FGitlabIntegrationIAPIIssue &Issue);
+    /** Fills in the derived fields of a label before it is stored */
+    void PrepareLabel(FGitlabIntegrationIAPILabel &Label);
+    /** The part of PrepareLabel which needs no API state, done by the decode tasks */
+    static void ParseLabelColors(FGitlabIntegrationIAPILabel &Label);
+    TMap<FString, int32> LabelIds;
+    TArray<FString> LabelNames;
+
+    /** Number of stored issues per interned label id */
+    int32 GetLabelIssueCount(int32 InternId) const {
+        return LabelIssueCounts.IsValidIndex(InternId) ? LabelIssueCounts[InternId] : 0;
+    }
+    TArray<int32> LabelIssueCounts;
+    void CountIssueLabels(const FGitlabIntegrationIAPIIssue &Issue, int32 Change);
+
+    /** Gitlab refuses more than 100 items per page */
+    static const int32 PageSize = 100;
+    /** How many pages of a single list may be requested at the same time, 1 fetches pages one after another */
+    int32 MaxConcurrentPages = 4;
+
+    /** Only ask for issues changed since the last complete load when refreshing */
+    bool bIncrementalSync = true;
+    /** Decode every page a second time through reflection and report differences */
+    bool bVerifyJsonDecoder = false;
+    /** Newest updated_at of a completed issue load per project id */
+    TMap<int32, FDateTime> IssueWatermarks;
+    /** Server the stored issues and labels came from, SaveCache writes nothing else */
+    FString StoreBaseUrl;
+
+    /** Conditional GET cache keyed by url, changes requests with their moving updated_after are not kept */
+    TMap<FString, FGitlabIntegrationIAPICacheEntry> ResponseCache;
+    /** Responses answered with 304 Not Modified */
+    int32 CacheHits = 0;
+    /** Responses which had to be downloaded */
+    int32 CacheMisses = 0;
+    /** Issue objects created by merges and issues updated in place, for the load statistics */
+    int32 IssuesAllocated = 0;
+    int32 IssuesUpdatedInPlace = 0;
+
+    /** Bump whenever the layout of the cache file changes */
+    static const int32 CacheFileVersion = 3;
+    /** Where projects, issues and labels are kept between editor sessions, empty disables it */
+    FString CacheFile;
 
     void SetRequestHeaders(TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request);
+    /** Keeps the validators of a decoded response so the next GET of the url can be answered with 304 */
+    void StoreResponse(FHttpResponsePtr Response, FGitlabIntegrationIAPICachedPayload Parsed = nullptr);
+
+    /** Every request goes through here instead of being sent right away */
+    FGitlabIntegrationIAPIRequestScheduler Scheduler;
+
+    /** Drops everything still on its way for the selected project, or for the whole server */
+    void CancelProjectRequests();
+    void CancelServerRequests();
 
 private:
     FHttpModule* Http;
 
+protected:
+    /** Carried by every request of the selected project and of the server, replaced when they change */
+    FGitlabIntegrationIAPICancellationTokenPtr ProjectToken = MakeShareable(new FGitlabIntegrationIAPICancellationToken());
+    FGitlabIntegrationIAPICancellationTokenPtr ServerToken = MakeShareable(new FGitlabIntegrationIAPICancellationToken());
+
+    /** Projections handed out by GetProjects, GetIssues and GetLabels, with the version they were built from */
+    TArray<TSharedPtr<FGitlabIntegrationIAPIProject>> SortedProjects;
+    uint32 SortedProjectsVersion = ~0u;
+    TArray<TSharedPtr<FGitlabIntegrationIAPIIssue>> IssueArray;
+    uint32 IssueArrayVersion = ~0u;
+    TArray<TSharedPtr<FGitlabIntegrationIAPILabel>> SortedLabels;
+    uint32 SortedLabelsVersion = ~0u;
+
+    struct FPendingDecode {
+        FHttpResponsePtr Response;
+        FGitlabIntegrationIAPICancellationTokenPtr Token;
+        FGitlabIntegrationIAPIDecodedCallback Callback;
+    };
+
+    /** Filled by the decode tasks, emptied on the game thread. Shared so tasks may outlive the API. */
+    TSharedPtr<TQueue<FGitlabIntegrationIAPIDecodedBody, EQueueMode::Mpsc>, ESPMode::ThreadSafe> DecodedBodies =
+        MakeShareable(new TQueue<FGitlabIntegrationIAPIDecodedBody, EQueueMode::Mpsc>());
+    TMap<int32, FPendingDecode> PendingDecodes;
+    int32 NextDecodeId = 0;
+    FDelegateHandle DecodeTickHandle;
+    /** Merges whatever the workers finished since the last tick */
+    bool ApplyDecodedBodies(float DeltaTime);
+
+    FGitlabIntegrationIAPIPagedFetch ProjectsFetch;
+    /** The full project list is only needed by the project picker, so it is loaded on first use */
+    bool bProjectsRequested = false;
+    bool bProjectsLoaded = false;
+    /** Projects of a group which are no longer seen are dropped, unless a page of the list failed */
+    bool bProjectFetchFailed = false;
+    TSet<int32> SeenProjectIds;
+    /** Issues by project id, the selected project or every project of the group */
+    TMap<int32, FGitlabIntegrationIAPIIssuePartition> Partitions;
+    int32 IssueFetchSerial = 0;
+    FGitlabIntegrationIAPIPagedFetch LabelsFetch;
+    bool bLabelFetchFailed = false;
+    TSet<int32> SeenLabelIds;
+
+    bool HandlePage(FGitlabIntegrationIAPIPagedFetch &Fetch, int32 Page, FHttpResponsePtr Response,
+                    TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed, TFunctionRef<void(int32)> RequestPage,
+                    TFunctionRef<void(FGitlabIntegrationIAPIDecodedPayload &)> MergePage);
+    void MergeProjectsPage(FGitlabIntegrationIAPIDecodedPayload &Page);
+    void MergeIssuesPage(FGitlabIntegrationIAPIIssuePartition &Partition, FGitlabIntegrationIAPIDecodedPayload &Page);
+    void MergeLabelsPage(FGitlabIntegrationIAPIDecodedPayload &Page);
+    /** Moves the items into the store and publishes what changed */
+    void MergeIssues(TArray<FGitlabIntegrationIAPIIssue> &Items);
+    void MergeLabels(TArray<FGitlabIntegrationIAPILabel> &Items);
+    void PublishIssues(const FGitlabIntegrationIAPIIssueDelta &Delta);
+    void PublishLabels(const FGitlabIntegrationIAPILabelDelta &Delta);
+    /** Empties issues, labels and partitions and tells the listeners */
+    void ResetStore();
+    /** Reconciles the partitions with the project list of the group and loads their issues */
+    void StartGroupPartitions();
+    /** Drops a project which left the group together with its issues */
+    void RemovePartition(int32 ProjectId);
+    /** Starts loading the issues of one partition, only those changed since its watermark with bChanges */
+    void FetchPartitionIssues(int32 ProjectId, EGitlabIntegrationIAPIRequestPriority Priority, bool bChanges);
+    /** "groups/<url encoded path>" */
+    FString GetGroupRoute() const;
+    /** Ends the running issue fetch of a partition, removing unseen issues after a complete full load */
+    void CompleteIssueFetch(int project_id);
+    /** A failed page leaves a hole below the watermark, the next refresh has to reload everything */
+    void FailIssueFetch(int project_id);
+    void CompleteLabelFetch();
+
 
 public:
     // Actual API calls
         //Projects
-    void GetProjectsRequest(int32 page);
-    void ProjectsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+    void ResolveProject();
+    void ProjectResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+    void ProjectSearchResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+    void ProjectSearchDecoded(TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed);
+    void EnsureProjectsLoaded();
+    bool AreProjectsLoading();
+    /** All projects of the server, or of the group in group mode */
+    void FetchProjects(EGitlabIntegrationIAPIRequestPriority Priority = EGitlabIntegrationIAPIRequestPriority::Interactive);
+    void GetProjectsRequest(int32 page, int32 serial);
+    void ProjectsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int32 page, int32 serial);
+    void ProjectsDecoded(FHttpResponsePtr Response, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed, int32 page, int32 serial);
         //Issues
-    void GetProjectIssuesRequest(int project_id, int32 page);
-    void GetProjectLabels(int project_id, int32 page);
-    void ProjectLabelsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-    void RefreshIssues();
-    void ProjectIssuesResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-    void RecordTimeSpent(TSharedPtr <FGitlabIntegrationIAPIIssue> issue, int time);
+    /** Issues (or their changes, see RefreshIssues) and labels of the selected project, or of the whole group */
+    virtual void FetchProjectContent(EGitlabIntegrationIAPIRequestPriority Priority = EGitlabIntegrationIAPIRequestPriority::Foreground);
+    virtual void FetchProjectIssues(EGitlabIntegrationIAPIRequestPriority Priority = EGitlabIntegrationIAPIRequestPriority::Foreground);
+    virtual void FetchProjectIssueChanges(EGitlabIntegrationIAPIRequestPriority Priority = EGitlabIntegrationIAPIRequestPriority::Foreground);
+    virtual void FetchProjectLabels(EGitlabIntegrationIAPIRequestPriority Priority = EGitlabIntegrationIAPIRequestPriority::Foreground);
+    void GetProjectIssuesRequest(int project_id, FString query, int32 page, int32 serial);
+    void GetProjectLabels(int project_id, int32 page, int32 serial);
+    void ProjectLabelsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int project_id, int32 page, int32 serial);
+    void ProjectLabelsDecoded(FHttpResponsePtr Response, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed, int project_id, int32 page, int32 serial);
+    void RefreshIssues(EGitlabIntegrationIAPIRequestPriority Priority = EGitlabIntegrationIAPIRequestPriority::Foreground);
+    void ProjectIssuesResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int project_id, FString query, int32 page, int32 serial);
+    void ProjectIssuesDecoded(FHttpResponsePtr Response, TSharedPtr<FGitlabIntegrationIAPIDecodedPayload> Parsed, int project_id, FString query, int32 page, int32 serial);
+    /**
+     * One conditional GET of the selected project. When its last_activity_at moved, a background issue sync is
+     * started. The callback tells whether there was activity and is always called.
+     */
+    void PollProjectActivity(std::function<void(bool)> Callback);
+    void ProjectActivityResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, std::function<void(bool)> Callback);
+    /** Applies an issue pushed by a webhook as if a page with just this issue had been fetched */
+    void ApplyIssueEvent(FGitlabIntegrationIAPIIssue Issue, TArray<FGitlabIntegrationIAPILabel> EventLabels);
+    virtual void RecordTimeSpent(TSharedPtr <FGitlabIntegrationIAPIIssue> issue, int time);
     void TimeSpentResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
 
-    TArray<FGitlabIntegrationIAPIProject> GetProjects();
-    TArray<TSharedPtr<FGitlabIntegrationIAPIIssue>> GetIssues();
-
-    TArray<TSharedPtr<FGitlabIntegrationIAPILabel>> GetLabels();
-    TSharedPtr<FGitlabIntegrationIAPILabel> GetLabel(FString &name);
+    /** Sorted by name_with_namespace, only rebuilt after ProjectsVersion changed */
+    const TArray<TSharedPtr<FGitlabIntegrationIAPIProject>> &GetProjects();
+    const TArray<TSharedPtr<FGitlabIntegrationIAPIIssue>> &GetIssues();
+    /** Ids of the stored issues of one project, null if it has no partition */
+    const TSet<int32> *GetProjectIssueIds(int32 ProjectId) const {
+        const FGitlabIntegrationIAPIIssuePartition *Partition = Partitions.Find(ProjectId);
+        return Partition != nullptr ? &Partition->IssueIds : nullptr;
+    }
+    /** Sorted by LabelLess, only rebuilt after LabelsVersion changed */
+    const TArray<TSharedPtr<FGitlabIntegrationIAPILabel>> &GetLabels();
+    static bool LabelLess(const TSharedPtr<FGitlabIntegrationIAPILabel> &A, const TSharedPtr<FGitlabIntegrationIAPILabel> &B);
+    /** Unknown names share one placeholder label */
+    TSharedPtr<const FGitlabIntegrationIAPILabel> GetLabel(const FString &name);
 };
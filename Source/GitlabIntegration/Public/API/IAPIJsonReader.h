@@ -0,0 +1,204 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "Templates/IntegralConstant.h"
+#include "JsonObjectConverter.h"
+#include "IAPI.h"
+
+/**
+ * Pull parser working directly on the UTF-8 body of a response.
+ * Values are read straight into their destination, everything the caller does not ask for is skipped
+ * without being decoded, so no intermediate FString of the whole body and no FJsonValue tree is built.
+ */
+class GITLABINTEGRATION_API FGitlabIntegrationIAPIJsonReader {
+public:
+    FGitlabIntegrationIAPIJsonReader(const uint8 *InData, int32 InLength);
+
+    /** Consumes the opening bracket */
+    bool BeginArray();
+    bool BeginObject();
+    /** Moves to the next element of the current array, false once the closing bracket was consumed */
+    bool NextElement();
+    /** Moves to the next key of the current object and consumes the colon, false once the closing brace was consumed */
+    bool NextKey();
+
+    /** Compares the current key without allocating */
+    bool KeyEquals(const ANSICHAR *Name, int32 NameLength) const {
+        return KeyLength == NameLength && FMemory::Memcmp(KeyStart, Name, NameLength) == 0;
+    }
+
+    /** The readers leave the destination untouched for null */
+    bool ReadString(FString &Out);
+    bool ReadInt(int32 &Out);
+    bool ReadBool(bool &Out);
+    bool ReadDateTime(FDateTime &Out);
+    bool ReadStringArray(TArray<FString> &Out);
+    bool SkipValue();
+
+    bool ReadValue(FString &Out) { return ReadString(Out); }
+    bool ReadValue(int32 &Out) { return ReadInt(Out); }
+    bool ReadValue(bool &Out) { return ReadBool(Out); }
+    bool ReadValue(FDateTime &Out) { return ReadDateTime(Out); }
+    bool ReadValue(TArray<FString> &Out) { return ReadStringArray(Out); }
+
+    bool IsValid() const { return !bError; }
+
+private:
+    const uint8 *Pos;
+    const uint8 *End;
+    const uint8 *KeyStart = nullptr;
+    int32 KeyLength = 0;
+    /** Set by Begin*, the first Next* call does not expect a comma */
+    bool bFirst = false;
+    bool bError = false;
+
+    bool Fail();
+    void SkipWhitespace();
+    bool Consume(uint8 Char);
+    bool ConsumeLiteral(const ANSICHAR *Literal, int32 Length);
+    bool ConsumeNull();
+    /** Finds the end of the string starting at Pos (after the quote) and consumes it */
+    bool ScanString(const uint8 *&Start, int32 &Length, bool &bEscaped, bool &bAscii);
+};
+
+/**
+ * One entry of a field table: json key and the function reading its value into the struct
+ */
+template <typename StructType>
+struct TGitlabIntegrationIAPIJsonField {
+    const ANSICHAR *Name;
+    int32 NameLength;
+    bool (*Read)(FGitlabIntegrationIAPIJsonReader &Reader, StructType &Out);
+};
+
+/** Reads a single member, instantiated once per field of a table */
+template <typename StructType, typename MemberType, MemberType StructType::*Member>
+struct TGitlabIntegrationIAPIJsonMember {
+    static bool Read(FGitlabIntegrationIAPIJsonReader &Reader, StructType &Out) {
+        return Reader.ReadValue(Out.*Member);
+    }
+};
+
+/**
+ * Field table of a struct. Types without a specialization are decoded through UStruct reflection.
+ */
+template <typename StructType>
+struct TGitlabIntegrationIAPIJsonFields {
+    enum { bHasTable = false };
+};
+
+template <>
+struct GITLABINTEGRATION_API TGitlabIntegrationIAPIJsonFields<FGitlabIntegrationIAPIProject> {
+    enum { bHasTable = true };
+    static TArrayView<const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPIProject>> Get();
+};
+
+template <>
+struct GITLABINTEGRATION_API TGitlabIntegrationIAPIJsonFields<FGitlabIntegrationIAPIIssue> {
+    enum { bHasTable = true };
+    static TArrayView<const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPIIssue>> Get();
+};
+
+template <>
+struct GITLABINTEGRATION_API TGitlabIntegrationIAPIJsonFields<FGitlabIntegrationIAPILabel> {
+    enum { bHasTable = true };
+    static TArrayView<const TGitlabIntegrationIAPIJsonField<FGitlabIntegrationIAPILabel>> Get();
+};
+
+/**
+ * Decodes response bodies into IAPI structs, using the field table when the struct has one
+ */
+struct FGitlabIntegrationIAPIJsonDecoder {
+    template <typename StructType>
+    static bool Decode(FGitlabIntegrationIAPIJsonReader &Reader, StructType &Out) {
+        TArrayView<const TGitlabIntegrationIAPIJsonField<StructType>> Fields = TGitlabIntegrationIAPIJsonFields<StructType>::Get();
+        if (!Reader.BeginObject()) return false;
+        while (Reader.NextKey()) {
+            const TGitlabIntegrationIAPIJsonField<StructType> *Match = nullptr;
+            for (const TGitlabIntegrationIAPIJsonField<StructType> &Field : Fields) {
+                if (Reader.KeyEquals(Field.Name, Field.NameLength)) {
+                    Match = &Field;
+                    break;
+                }
+            }
+            if (Match != nullptr) {
+                Match->Read(Reader, Out);
+            } else {
+                Reader.SkipValue();
+            }
+        }
+        return Reader.IsValid();
+    }
+
+    template <typename StructType>
+    static bool DecodeArray(const TArray<uint8> &Content, TArray<StructType> &Out) {
+        return DecodeArray(Content, Out, TIntegralConstant<bool, TGitlabIntegrationIAPIJsonFields<StructType>::bHasTable>());
+    }
+
+    template <typename StructType>
+    static bool DecodeObject(const TArray<uint8> &Content, StructType &Out) {
+        return DecodeObject(Content, Out, TIntegralConstant<bool, TGitlabIntegrationIAPIJsonFields<StructType>::bHasTable>());
+    }
+
+    /** Reflection based decoding, used for types without a field table and to verify the tables */
+    template <typename StructType>
+    static bool DecodeArrayWithReflection(const TArray<uint8> &Content, TArray<StructType> &Out) {
+        FUTF8ToTCHAR Converted((const ANSICHAR *) Content.GetData(), Content.Num());
+        return FJsonObjectConverter::JsonArrayStringToUStruct(FString(Converted.Length(), Converted.Get()), &Out, 0, 0);
+    }
+
+    template <typename StructType>
+    static bool DecodeObjectWithReflection(const TArray<uint8> &Content, StructType &Out) {
+        FUTF8ToTCHAR Converted((const ANSICHAR *) Content.GetData(), Content.Num());
+        return FJsonObjectConverter::JsonObjectStringToUStruct<StructType>(FString(Converted.Length(), Converted.Get()), &Out, 0, 0);
+    }
+
+    /** Decodes with both paths and reports the first element that differs */
+    template <typename StructType>
+    static bool VerifyArrayParity(const TArray<uint8> &Content, const TArray<StructType> &Decoded, FString &OutMismatch) {
+        TArray<StructType> Reflected;
+        DecodeArrayWithReflection(Content, Reflected);
+        if (Reflected.Num() != Decoded.Num()) {
+            OutMismatch = FString::Printf(TEXT("%d elements, reflection found %d"), Decoded.Num(), Reflected.Num());
+            return false;
+        }
+        for (int32 Index = 0; Index < Decoded.Num(); Index++) {
+            if (!StructType::StaticStruct()->CompareScriptStruct(&Decoded[Index], &Reflected[Index], 0)) {
+                OutMismatch = FString::Printf(TEXT("element %d differs"), Index);
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    template <typename StructType>
+    static bool DecodeArray(const TArray<uint8> &Content, TArray<StructType> &Out, TIntegralConstant<bool, true>) {
+        FGitlabIntegrationIAPIJsonReader Reader(Content.GetData(), Content.Num());
+        if (!Reader.BeginArray()) return false;
+        while (Reader.NextElement()) {
+            int32 Index = Out.AddDefaulted();
+            if (!Decode(Reader, Out[Index])) return false;
+        }
+        return Reader.IsValid();
+    }
+
+    template <typename StructType>
+    static bool DecodeArray(const TArray<uint8> &Content, TArray<StructType> &Out, TIntegralConstant<bool, false>) {
+        return DecodeArrayWithReflection(Content, Out);
+    }
+
+    template <typename StructType>
+    static bool DecodeObject(const TArray<uint8> &Content, StructType &Out, TIntegralConstant<bool, true>) {
+        FGitlabIntegrationIAPIJsonReader Reader(Content.GetData(), Content.Num());
+        return Decode(Reader, Out);
+    }
+
+    template <typename StructType>
+    static bool DecodeObject(const TArray<uint8> &Content, StructType &Out, TIntegralConstant<bool, false>) {
+        return DecodeObjectWithReflection(Content, Out);
+    }
+};
@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+/** Which requests go first when the scheduler has to hold some back */
+enum class EGitlabIntegrationIAPIRequestPriority : uint8 {
+    /** Directly triggered by the user (time tracking, project picker, refresh button) */
+    Interactive,
+    /** Data of the selected project */
+    Foreground,
+    /** Reconciling cached data, nobody waits for it */
+    Background,
+    Num
+};
+
+/** Shared by all requests of one project or server, cancelling it drops every one of them */
+struct FGitlabIntegrationIAPICancellationToken {
+    /** Counts up with every project or server switch, for the log */
+    int32 Generation = 0;
+    bool bCancelled = false;
+};
+
+typedef TSharedPtr<FGitlabIntegrationIAPICancellationToken> FGitlabIntegrationIAPICancellationTokenPtr;
+
+/**
+ * Queues requests instead of sending them right away. Requests leave the queue by priority, limited by the
+ * number of requests in flight per host and by a token bucket. The bucket follows the RateLimit-* headers of
+ * the server and a 429 pauses the queue for Retry-After seconds before the request is sent again.
+ * GETs which fail with a network error or a 5xx are retried with a jittered exponential backoff, and a GET of
+ * an url which is already queued or in flight is not sent again, its caller gets the pending response, unless
+ * nobody is left waiting for that one.
+ * Requests whose cancellation token was cancelled never reach their caller, whether queued or in flight.
+ */
+class GITLABINTEGRATION_API FGitlabIntegrationIAPIRequestScheduler {
+public:
+    ~FGitlabIntegrationIAPIRequestScheduler();
+
+    void Enqueue(TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request, EGitlabIntegrationIAPIRequestPriority Priority,
+                 const FGitlabIntegrationIAPICancellationTokenPtr &Token = nullptr);
+    /** Drops queued requests of cancelled tokens and cancels those in flight, call after cancelling a token */
+    void CancelRequests();
+    void SetLimits(int32 MaxInFlight, float RequestsPerSecond);
+
+    int32 GetQueueDepth() const;
+    int32 GetInFlight() const { return TotalInFlight; }
+    void LogStats() const;
+
+private:
+    struct FQueuedRequest {
+        TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request;
+        FString Host;
+        /** Url of a GET, empty for requests which must not be retried or shared */
+        FString Url;
+        double EnqueuedAt = 0.0;
+        /** Backoff, not sent before this time */
+        double NotBefore = 0.0;
+        int32 RateLimitRetries = 0;
+        int32 Retries = 0;
+        /** The caller's delegate once the request has been sent before */
+        FHttpRequestCompleteDelegate Completion;
+        FGitlabIntegrationIAPICancellationTokenPtr Token;
+    };
+
+    struct FWaitingGet {
+        FHttpRequestCompleteDelegate Completion;
+        FGitlabIntegrationIAPICancellationTokenPtr Token;
+    };
+
+    struct FPendingGet {
+        /** The queued or in flight GET the waiters are attached to */
+        FHttpRequestPtr Request;
+        FGitlabIntegrationIAPICancellationTokenPtr Token;
+        TArray<FWaitingGet> Waiting;
+    };
+
+    struct FInFlightRequest {
+        FHttpRequestPtr Request;
+        FString Url;
+        FGitlabIntegrationIAPICancellationTokenPtr Token;
+    };
+
+    struct FPriorityStats {
+        int32 Sent = 0;
+        double TotalWait = 0.0;
+        double MaxWait = 0.0;
+        int32 MaxDepth = 0;
+    };
+
+    /** Sends whatever the limits allow */
+    void Pump();
+    bool Tick(float DeltaTime);
+    void Send(FQueuedRequest &&Queued, EGitlabIntegrationIAPIRequestPriority Priority);
+    /** State is the queued request without the request itself, which would otherwise own its own delegate */
+    void HandleComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
+                        FQueuedRequest State, EGitlabIntegrationIAPIRequestPriority Priority);
+    void Requeue(FHttpRequestPtr Request, FQueuedRequest &&State, EGitlabIntegrationIAPIRequestPriority Priority);
+    static bool IsCancelled(const FGitlabIntegrationIAPICancellationTokenPtr &Token) {
+        return Token.IsValid() && Token->bCancelled;
+    }
+    /** Nobody waits for the response any more, neither the caller nor anyone attached to the same GET */
+    bool IsDropped(const FHttpRequestPtr &Request, const FGitlabIntegrationIAPICancellationTokenPtr &Token,
+                   const FString &Url) const;
+    /** Removes the pending GET of the url if Request is the one it belongs to, a newer GET of the url keeps its entry */
+    void ReleasePendingGet(const FString &Url, const FHttpRequestPtr &Request, TArray<FWaitingGet> *OutWaiting = nullptr);
+    static bool ShouldRetry(FHttpResponsePtr Response, bool bWasSuccessful);
+    /** Adjusts the bucket to what the server says is left of the current window */
+    void ApplyRateLimitHeaders(FHttpResponsePtr Response);
+    static FString GetHost(const FString &Url);
+
+    TArray<FQueuedRequest> Queues[(int32) EGitlabIntegrationIAPIRequestPriority::Num];
+    FPriorityStats Stats[(int32) EGitlabIntegrationIAPIRequestPriority::Num];
+    TMap<FString, int32> InFlightPerHost;
+    /** GETs queued or in flight by url, with the callers which asked for the same url meanwhile */
+    TMap<FString, FPendingGet> PendingGets;
+    TArray<FInFlightRequest> InFlightRequests;
+    int32 TotalInFlight = 0;
+
+    int32 MaxInFlightPerHost = 6;
+    /** Configured rate, the server can only lower it */
+    float MaxRate = 10.0f;
+    float Rate = 10.0f;
+    float Tokens = 10.0f;
+    double LastRefill = 0.0;
+    /** Nothing is sent before this time after a 429 or an exhausted rate limit */
+    double PausedUntil = 0.0;
+    int32 RateLimited = 0;
+    int32 Retried = 0;
+    int32 Coalesced = 0;
+    int32 Cancelled = 0;
+
+    FDelegateHandle TickHandle;
+};
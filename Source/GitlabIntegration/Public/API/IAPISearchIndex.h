@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Trigram index over issue titles plus a lookup by issue number.
+ * A query only yields the issues containing every trigram of the search text, the caller still checks
+ * those few candidates with FString::Contains.
+ */
+class GITLABINTEGRATION_API FGitlabIntegrationIAPISearchIndex {
+public:
+    /** Adds or replaces an issue */
+    void Add(int32 IssueId, int32 Number, const FString &Title);
+    void Remove(int32 IssueId);
+    void Empty();
+
+    /**
+     * Collects the issues which may match the search, either by title or by a #number in it.
+     * Returns false when the search cannot be narrowed down (shorter than a trigram), then every issue is a candidate.
+     */
+    bool Query(const FString &Search, TSet<int32> &OutIssueIds) const;
+
+    /** The numbers written as #123 in a search */
+    static void ParseNumbers(const FString &Search, TArray<int32> &OutNumbers);
+
+private:
+    static void GetTrigrams(const FString &Text, TArray<uint64> &OutTrigrams);
+
+    TMap<uint64, TSet<int32>> Postings;
+    TMap<int32, TArray<uint64>> IssueTrigrams;
+    TMap<int32, TArray<int32>> NumberToIssues;
+    TMap<int32, int32> IssueNumbers;
+};
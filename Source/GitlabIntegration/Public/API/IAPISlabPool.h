@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/TypeCompatibleBytes.h"
+
+/**
+ * Storage for the issues and labels of the store, SlabSize objects at a time instead of one by one. Items are
+ * moved into a free slot and stay at their address. Each pointer handed out has a reference count of its own,
+ * whose deleter destroys the item in its slot and gives the slot back, so an item lives exactly as long as the
+ * store, a delta, a view or a row holds it and closed issues never keep their strings around. A slab is freed
+ * once the pool dropped it and its last item is gone.
+ */
+template <typename ItemType, int32 SlabSize = 256>
+class TGitlabIntegrationIAPISlabPool {
+public:
+    TSharedPtr<ItemType> Add(ItemType &&Item) {
+        if (!Current.IsValid() || !Current->HasRoom()) {
+            FindSlabWithRoom();
+        }
+        const TSharedPtr<FSlab> Slab = Current;
+        const int32 Index = Slab->FreeSlots.Num() > 0 ? Slab->FreeSlots.Pop(false) : Slab->Unused++;
+        ItemType *Stored = new (Slab->Items[Index].GetTypedPtr()) ItemType(MoveTemp(Item));
+        Slab->Live++;
+        // The deleter keeps the slab alive for items that outlive the pool
+        return MakeShareable(Stored, [Slab, Index](ItemType *Dead) {
+            Dead->~ItemType();
+            Slab->FreeSlots.Add(Index);
+            Slab->Live--;
+        });
+    }
+
+    /** Lets go of the slabs, items still held elsewhere keep their own */
+    void Empty() {
+        Slabs.Empty();
+        Current.Reset();
+    }
+
+    int32 GetSlabCount() const { return Slabs.Num(); }
+
+    /** Slabs allocated since the pool was created, for the load statistics */
+    int32 SlabsAllocated = 0;
+
+private:
+    struct FSlab {
+        TTypeCompatibleBytes<ItemType> Items[SlabSize];
+        /** Slots given back by their deleter, reused before the untouched ones */
+        TArray<int32, TFixedAllocator<SlabSize>> FreeSlots;
+        /** Slots from here on were never used */
+        int32 Unused = 0;
+        /** Items constructed and not yet destroyed */
+        int32 Live = 0;
+
+        bool HasRoom() const { return FreeSlots.Num() > 0 || Unused < SlabSize; }
+    };
+
+    /** Only runs when the current slab is full, empty slabs besides the one picked are dropped on the way */
+    void FindSlabWithRoom() {
+        Current.Reset();
+        for (int32 Index = Slabs.Num() - 1; Index >= 0; Index--) {
+            if (!Slabs[Index]->HasRoom()) continue;
+            if (!Current.IsValid()) {
+                Current = Slabs[Index];
+            } else if (Slabs[Index]->Live == 0) {
+                Slabs.RemoveAtSwap(Index);
+            }
+        }
+        if (!Current.IsValid()) {
+            Current = MakeShared<FSlab>();
+            Slabs.Add(Current);
+            SlabsAllocated++;
+        }
+    }
+
+    TArray<TSharedPtr<FSlab>> Slabs;
+    /** Slab new items go to */
+    TSharedPtr<FSlab> Current;
+};
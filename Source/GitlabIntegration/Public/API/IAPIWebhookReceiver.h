@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HttpServerRequest.h"
+#include "HttpResultCallback.h"
+#include "HttpRouteHandle.h"
+#include "IHttpRouter.h"
+#include "IAPI.h"
+
+/**
+ * Receives Gitlab issue webhooks on a local port and applies each event to the store of the API, so changes show
+ * up without polling. Labels of the issue arrive with the event and are merged too. Requests without the
+ * configured secret in X-Gitlab-Token are refused.
+ */
+class GITLABINTEGRATION_API FGitlabIntegrationIAPIWebhookReceiver {
+public:
+    ~FGitlabIntegrationIAPIWebhookReceiver();
+
+    /** Listens for POSTs to Path on Port, false if the route could not be bound or no secret is set */
+    bool Start(IAPI *InApi, uint32 Port, const FString &Path, const FString &InSecret);
+    void Stop();
+    bool IsRunning() const { return RouteHandle.IsValid(); }
+
+private:
+    /** Feeds recorded requests to HandleRequest without listening on a port */
+    friend class FGitlabIntegrationWebhookReceiverTest;
+
+    bool HandleRequest(const FHttpServerRequest &Request, const FHttpResultCallback &OnComplete);
+    static FString GetHeader(const FHttpServerRequest &Request, const FString &Name);
+    /** Compares without stopping at the first difference */
+    static bool SecretMatches(const FString &Token, const FString &Expected);
+    static bool ParseIssueEvent(const TSharedPtr<FJsonObject> &Event, FGitlabIntegrationIAPIIssue &OutIssue,
+                                TArray<FGitlabIntegrationIAPILabel> &OutLabels);
+    /** Webhooks use either ISO 8601 or "2019-08-23 12:00:00 UTC" depending on the Gitlab version, false for neither */
+    static bool ParseTimestamp(const FString &Value, FDateTime &Out);
+
+    IAPI *Api = nullptr;
+    FString Secret;
+    TSharedPtr<IHttpRouter> Router;
+    FHttpRouteHandle RouteHandle;
+    int32 EventsApplied = 0;
+    int32 EventsRefused = 0;
+};
@@ -5,17 +5,40 @@
 #include "CoreMinimal.h"
 #include "Engine/EngineTypes.h"
 #include "Modules/ModuleManager.h"
+#include "Containers/Ticker.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STileView.h"
 #include "Widgets/Layout/SWrapBox.h"
+#include "Widgets/Input/SComboButton.h"
 #include "API/GitlabAPI.h"
+#include "API/IAPIWebhookReceiver.h"
 #include "EditorStyleSet.h"
 
+/** What an issue matching the search was counted under in the facet counts */
+struct FGitlabIntegrationIssueFacets {
+    FGitlabIntegrationIAPILabelIds LabelIds;
+    FName State;
+    /** Passes the label filter too, only these are listed and counted by state */
+    bool bInView = false;
+};
+
 class FToolBarBuilder;
 class FMenuBuilder;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogGitlabIntegration, Log, All);
 
+/** Issue row kept alive between generations, with the widgets that change when the issue is updated */
+struct FGitlabIntegrationIssueRow {
+    TSharedPtr<ITableRow> Row;
+    TSharedPtr<STextBlock> Title;
+    TSharedPtr<STextBlock> State;
+    TSharedPtr<SWrapBox> Labels;
+    /** Labels the wrap box was filled with */
+    FGitlabIntegrationIAPILabelIds LabelIds;
+    uint64 LastUsed = 0;
+};
+
 class FGitlabIntegrationModule : public IModuleInterface
 {
 public:
@@ -32,8 +55,34 @@ private:
 
 	void AddToolbarExtension(FToolBarBuilder& Builder);
 	void AddMenuExtension(FMenuBuilder& Builder);
+	/** Marks the issue or label view dirty, the rebuild happens once in Tick */
+	void RequestIssueRefresh();
+    void RequestLabelRefresh();
+    bool Tick(float DeltaTime);
+    /** Apply store changes to IssueList without rebuilding it */
+    void HandleIssueDelta(const FGitlabIntegrationIAPIIssueDelta &Delta);
+    void HandleLabelDelta(const FGitlabIntegrationIAPILabelDelta &Delta);
+    /** Project filter and search, the label filter is applied by CollectIssueFacets */
+    bool IssueMatchesSearch(const FGitlabIntegrationIAPIIssue &Issue) const;
+    /** #iid, prefixed with the project name when a whole group is shown */
+    FText GetIssueReference(const FGitlabIntegrationIAPIIssue &Issue) const;
+    bool IssueLess(const TSharedPtr<FGitlabIntegrationIAPIIssue> &A, const TSharedPtr<FGitlabIntegrationIAPIIssue> &B) const;
+    void InsertIssue(const TSharedPtr<FGitlabIntegrationIAPIIssue> &Issue);
+    void RemoveIssue(const TSharedPtr<FGitlabIntegrationIAPIIssue> &Issue);
+    /** Counts the issue under its current labels and lists it if it passes the filter, or drops it when it no longer matches */
+    void TrackIssue(const TSharedPtr<FGitlabIntegrationIAPIIssue> &Issue);
+    void UntrackIssue(const TSharedPtr<FGitlabIntegrationIAPIIssue> &Issue);
+    /** Labels the issue counts for, true if the label filter lets it into the list */
+    bool CollectIssueFacets(const FGitlabIntegrationIAPIIssue &Issue, FGitlabIntegrationIssueFacets &Facets) const;
+    void CountIssueFacets(const FGitlabIntegrationIssueFacets &Facets, int32 Change);
+    void ClearIssueView();
+    int32 GetViewLabelCount(int32 InternId) const;
+    FText GetIssueViewSummary();
+    bool LabelMatches(const FGitlabIntegrationIAPILabel &Label) const;
+    void InsertLabel(const TSharedPtr<FGitlabIntegrationIAPILabel> &Label);
 	void RefreshIssues();
     void RefreshLabels();
+    void RefreshProjects();
 
 	TSharedRef<class SDockTab> OnSpawnPluginTab(const class FSpawnTabArgs& SpawnTabArgs);
 
@@ -42,35 +91,92 @@ private:
     TSharedRef<SWidget> GenerateProjectList();
 
     TSharedRef<ITableRow> GenerateIssueWidget(TSharedPtr<FGitlabIntegrationIAPIIssue> IssueInfo, const TSharedRef<STableViewBase>& OwnerTable);
+    void UpdateIssueRow(FGitlabIntegrationIssueRow &Row, const FGitlabIntegrationIAPIIssue &Issue);
+    void FillIssueRowLabels(FGitlabIntegrationIssueRow &Row, const FGitlabIntegrationIAPIIssue &Issue);
+    void TrimIssueRows();
 
-    TSharedRef<SHorizontalBox> GenerateLabelWidget(TSharedPtr<FGitlabIntegrationIAPILabel> LabelInfo, bool OnIssue);
+    TSharedRef<ITableRow> GenerateLabelTile(TSharedPtr<FGitlabIntegrationIAPILabel> LabelInfo, const TSharedRef<STableViewBase>& OwnerTable);
+    TSharedRef<SHorizontalBox> GenerateLabelWidget(TSharedPtr<const FGitlabIntegrationIAPILabel> LabelInfo, bool OnIssue);
 
     IAPI* Api;
 
-    FTimerHandle IssueTracking;
+    /** One shot ticker of the next background activity check */
+    FDelegateHandle PollHandle;
+    /** Current delay between checks, between the min and max poll interval of the settings */
+    float PollInterval = 0.0f;
+    FDelegateHandle TickHandle;
+    bool bIssuesDirty = false;
+    bool bLabelsDirty = false;
+    /** Time of the first refresh request not applied yet */
+    double IssueRefreshRequestedAt = 0.0;
+    float IssueRefreshDebounce = 0.0f;
+    /** Requests received and rebuilds actually done, the difference was merged */
+    int32 IssueRefreshRequests = 0;
+    int32 IssueRefreshesRun = 0;
     FString IssueSearch;
     bool IssueSortNewFirst;
+    /** Project of the group the list is narrowed to, -1 shows the whole group */
+    int32 ProjectFilter = -1;
 
 private:
+    /** Drives the view with a store of its own, without the tab or the settings page */
+    friend class FGitlabIntegrationGroupViewTest;
+
 	TSharedPtr<class FUICommandList> PluginCommands;
 
     void RegisterSettings();
     void UnregisterSettings();
     bool HandleSettingsSaved();
+    /** Starts, restarts or stops the webhook receiver as configured */
+    void UpdateWebhookReceiver();
+    /** Background polling, one check at a time on PollHandle */
+    void SchedulePoll();
+    bool PollProjectActivity(float DeltaTime);
+    void HandlePollResult(bool bActivity);
     void HandleProjectSelection(FGitlabIntegrationIAPIProject project);
     void FinishTimeTracking(TSharedPtr<FGitlabIntegrationIAPIIssue> issue);
 
+    FGitlabIntegrationIAPIWebhookReceiver WebhookReceiver;
+
     TSharedPtr<STextBlock> ProjectSelectionButtonText;
-    /** Holds the filtered list of issues */
+    TSharedPtr<SComboButton> ProjectComboButton;
+    /** Projects offered by the project picker, sorted by name */
+    TArray<TSharedPtr<FGitlabIntegrationIAPIProject>> ProjectList;
+    /** Api->ProjectsVersion ProjectList was copied at */
+    uint32 ProjectListVersion = ~0u;
+    TSharedPtr<SListView<TSharedPtr<FGitlabIntegrationIAPIProject>>> ProjectListView;
+    /** Holds the filtered list of issues, kept sorted by IssueLess */
     TArray<TSharedPtr<FGitlabIntegrationIAPIIssue>> IssueList;
+    /** Issues matching the search by id, IssueList holds those in view */
+    TMap<int32, FGitlabIntegrationIssueFacets> IssueListFacets;
+    /** Issues per interned label id, each counted as if the label's own selection or exclusion was off,
+     * and issues of IssueList per state, kept up to date with every insert and removal */
+    TArray<int32> ViewLabelCounts;
+    TMap<FName, int32> ViewStateCounts;
+    FText IssueViewSummary;
+    bool bIssueViewSummaryDirty = true;
+    /** #numbers of IssueSearch, parsed when the list is rebuilt */
+    TArray<int32> IssueSearchNumbers;
+    bool IssueSearchEmpty = true;
     TMap<TSharedPtr<FGitlabIntegrationIAPIIssue>, FDateTime> TimeTrackingMap;
-    TMap<TSharedPtr<FGitlabIntegrationIAPIIssue>, TSharedPtr<SBorder>> TimeTrackingBorderMap;
+
+    /** Rows by issue id, rows scrolled out of view are reused instead of rebuilt */
+    TMap<int32, FGitlabIntegrationIssueRow> IssueRows;
+    uint64 IssueRowUseCounter = 0;
+    /** Rows kept beyond the visible ones, the least recently used are dropped first */
+    static const int32 IssueRowCacheSize = 256;
 
     /** Holds the message type list view. */
     TSharedPtr<SListView<TSharedPtr<FGitlabIntegrationIAPIIssue>>> IssueListView;
 
+    /** Labels shown in the label bar, filtered by LabelSearch and sorted by name */
     TArray<TSharedPtr<FGitlabIntegrationIAPILabel>> LabelList;
-    TSharedPtr<SWrapBox> LabelWrapBox;
-    TArray<FString> SelectedLabels;
+    TSharedPtr<STileView<TSharedPtr<FGitlabIntegrationIAPILabel>>> LabelTileView;
+    FString LabelSearch;
+    /** Issues need one of these labels, or all of them with LabelFilterMatchAll */
+    FGitlabIntegrationIAPILabelSet SelectedLabels;
+    /** Issues with any of these labels are hidden */
+    FGitlabIntegrationIAPILabelSet ExcludedLabels;
+    bool LabelFilterMatchAll = false;
 
 };